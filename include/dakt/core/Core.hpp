@@ -1,9 +1,16 @@
 // Aggregate header for DaktLib-Core public surface.
 #pragma once
 
+#include "types/ErrorCode.hpp"
+#include "types/ImageView.hpp"
+#include "types/Rect.hpp"
+#include "types/RectSoA.hpp"
 #include "types/Result.hpp"
+#include "types/ResultBatch.hpp"
 #include "types/Span.hpp"
+#include "types/SpanRanges.hpp"
 #include "types/StringView.hpp"
+#include "types/Symbol.hpp"
 
 #include "concepts/CoreConcepts.hpp"
 
@@ -16,6 +23,38 @@
 #include "logging/NullLogger.hpp"
 #include "memory/SystemAllocator.hpp"
 
+#include "hash/Hash.hpp"
+#include "platform/CpuTopology.hpp"
+#include "platform/Futex.hpp"
+#include "platform/Simd.hpp"
+#include "platform/Thread.hpp"
+
+#include "concurrency/AdaptiveMutex.hpp"
+#include "concurrency/EpochManager.hpp"
+#include "concurrency/Event.hpp"
+#include "concurrency/HazardPointers.hpp"
+#include "concurrency/MpmcQueue.hpp"
+#include "concurrency/Parallel.hpp"
+#include "concurrency/Reclaim.hpp"
+#include "concurrency/SeqLock.hpp"
+#include "concurrency/SpscQueue.hpp"
+#include "concurrency/TaskGraph.hpp"
+#include "concurrency/ThreadPool.hpp"
+#include "concurrency/WaitGroup.hpp"
+
+#include "region/DirtyRegionTracker.hpp"
+#include "region/FrameDiff.hpp"
+#include "region/RegionRegistry.hpp"
+
+#include "text/AhoCorasick.hpp"
+#include "text/AsciiCase.hpp"
+#include "text/InlineString.hpp"
+#include "text/Numbers.hpp"
+#include "text/Split.hpp"
+#include "text/StringBuilder.hpp"
+#include "text/StringInterner.hpp"
+#include "text/Utf8.hpp"
+
 namespace dakt::core {
 // Intentionally empty: this header simply aggregates the core surface.
 }
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "../platform/Futex.hpp"
+#include "../platform/Simd.hpp"
+
+namespace dakt::core {
+
+// Spin-then-park mutex on one futex word (Drepper, "Futexes Are Tricky",
+// mutex 3): 0 unlocked, 1 locked, 2 locked with possible sleepers. An
+// uncontended lock() and unlock() are one atomic RMW each; unlock() enters
+// the kernel only when someone may be asleep.
+//
+// A contended lock() first spins, read-only, for a budget that follows how
+// long recent acquisitions took to spin (glibc's adaptive mutex heuristic):
+// short critical sections are taken without sleeping, long ones stop
+// burning cycles quickly. Spinning stops at once when others already sleep.
+//
+// Satisfies Lockable, so std::lock_guard and std::unique_lock apply. The
+// mutex fills its own cache line: spinners polling the word then never
+// slow down writes to neighbouring data.
+class alignas(kCacheLineSize) AdaptiveMutex {
+public:
+  static constexpr std::uint32_t kMaxSpin = 1000;
+
+  AdaptiveMutex() noexcept = default;
+  AdaptiveMutex(const AdaptiveMutex &) = delete;
+  AdaptiveMutex &operator=(const AdaptiveMutex &) = delete;
+
+  void lock() noexcept {
+    std::uint32_t expected = kUnlocked;
+    if (!state_.compare_exchange_strong(expected, kLocked,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+      lockContended();
+    }
+  }
+
+  [[nodiscard]] bool try_lock() noexcept {
+    std::uint32_t expected = kUnlocked;
+    return state_.compare_exchange_strong(expected, kLocked,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+  }
+
+  void unlock() noexcept {
+    if (state_.exchange(kUnlocked, std::memory_order_release) == kSleepers) {
+      futexWakeOne(state_);
+    }
+  }
+
+private:
+  static constexpr std::uint32_t kUnlocked = 0;
+  static constexpr std::uint32_t kLocked = 1;
+  static constexpr std::uint32_t kSleepers = 2;
+
+  void lockContended() noexcept {
+    const std::uint32_t estimate = spinEstimate_.load(std::memory_order_relaxed);
+    const std::uint32_t limit = std::min(kMaxSpin, estimate * 2 + 10);
+    std::uint32_t spins = 0;
+    for (; spins < limit; ++spins) {
+      std::uint32_t state = state_.load(std::memory_order_relaxed);
+      if (state == kSleepers) {
+        break;
+      }
+      if (state == kUnlocked &&
+          state_.compare_exchange_weak(state, kLocked,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        adjustEstimate(estimate, spins);
+        return;
+      }
+      cpuRelax();
+    }
+    adjustEstimate(estimate, spins);
+    // Marking the word as having sleepers is what makes unlock() wake us;
+    // a thread that gets the lock this way keeps the mark, since others
+    // may still be asleep.
+    while (state_.exchange(kSleepers, std::memory_order_acquire) !=
+           kUnlocked) {
+      futexWait(state_, kSleepers);
+    }
+  }
+
+  // Moves the estimate an eighth of the way towards the latest spin count.
+  void adjustEstimate(std::uint32_t estimate, std::uint32_t spins) noexcept {
+    const auto delta = (static_cast<std::int32_t>(spins) -
+                        static_cast<std::int32_t>(estimate)) /
+                       8;
+    spinEstimate_.store(static_cast<std::uint32_t>(
+                            static_cast<std::int32_t>(estimate) + delta),
+                        std::memory_order_relaxed);
+  }
+
+  std::atomic<std::uint32_t> state_{kUnlocked};
+  // Written only by contended lockers, so it shares the line.
+  std::atomic<std::uint32_t> spinEstimate_{0};
+};
+
+} // namespace dakt::core
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../platform/Simd.hpp"
+#include "Reclaim.hpp"
+
+namespace dakt::core {
+
+// Epoch-based reclamation (Fraser, 2004). Readers pin the current global
+// epoch while they hold pointers into a shared structure; writers retire
+// unlinked nodes into per-thread bags tagged with the epoch of retirement.
+// The global epoch advances only when every pinned thread has observed it,
+// so a bag retired in epoch e is unreachable once the epoch reaches e + 2.
+//
+// pin() costs one atomic exchange on the thread's own cache line. Each
+// thread gets a record on first use, cached thread-locally and returned when
+// the thread exits; its unreclaimed bags then pass to the manager. Every 64
+// retirements a thread tries to advance the epoch and frees its expired bags.
+//
+// One reader that stays pinned holds back reclamation for every thread, so
+// guards should be short-lived.
+class EpochManager {
+  struct Record;
+
+public:
+  explicit EpochManager(IAllocator &allocator);
+  // Reclaims everything still retired. No thread may be pinned.
+  ~EpochManager();
+
+  EpochManager(const EpochManager &) = delete;
+  EpochManager &operator=(const EpochManager &) = delete;
+
+  // Keeps the calling thread pinned while alive. Guards nest.
+  class Guard {
+  public:
+    Guard(Guard &&other) noexcept
+        : record_(std::exchange(other.record_, nullptr)) {}
+    Guard &operator=(Guard &&) = delete;
+    Guard(const Guard &) = delete;
+    ~Guard() {
+      if (record_ != nullptr) {
+        EpochManager::unpin(*record_);
+      }
+    }
+
+  private:
+    friend class EpochManager;
+    explicit Guard(Record *record) noexcept : record_(record) {}
+    Record *record_;
+  };
+
+  [[nodiscard]] Guard pin() {
+    Record &record = localRecord();
+    if (record.nesting++ == 0) {
+      const std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+      // seq_cst RMW: the pin must be visible before any pointer is loaded.
+      record.state.exchange((epoch << 1) | 1, std::memory_order_seq_cst);
+    }
+    return Guard(&record);
+  }
+
+  // Schedules `object` to be destroyed and its memory returned to the
+  // manager's allocator once no pinned reader can reach it.
+  template <typename T> void retire(T *object) {
+    retire(object, &detail::reclaim::destroyAndFree<T>, 0);
+  }
+  // Schedules `size` raw bytes at `ptr` to be returned to the allocator.
+  void retire(void *ptr, std::size_t size) {
+    retire(ptr, &detail::reclaim::freeBytes, size);
+  }
+  void retire(void *ptr, ReclaimFn fn, std::size_t arg);
+
+  // Tries to advance the epoch and frees the calling thread's expired bags.
+  void collect();
+
+  [[nodiscard]] std::uint64_t epoch() const noexcept {
+    return epoch_.load(std::memory_order_acquire);
+  }
+  // Retired objects not yet reclaimed, across all threads. Approximate
+  // while other threads retire or collect.
+  [[nodiscard]] std::size_t pendingCount() const noexcept;
+
+  [[nodiscard]] IAllocator &allocator() const noexcept { return allocator_; }
+
+private:
+  // Fixed-size chunk of retired entries, tagged with its retirement epoch
+  // so it can be handed over on its own when a thread exits.
+  struct Block;
+  struct Bag {
+    std::uint64_t epoch{0};
+    Block *blocks{nullptr};
+  };
+
+  struct alignas(kCacheLineSize) Record {
+    // (epoch << 1) | pinned, read by threads advancing the epoch.
+    std::atomic<std::uint64_t> state{0};
+    std::atomic<bool> owned{false};
+    std::atomic<std::size_t> pending{0};
+    Record *next{nullptr};
+    // Owner-thread state.
+    std::uint32_t nesting{0};
+    std::uint32_t sinceCollect{0};
+    Bag bags[3];
+    Block *spare{nullptr};
+  };
+
+  static void unpin(Record &record) noexcept {
+    if (--record.nesting == 0) {
+      record.state.store(0, std::memory_order_release);
+    }
+  }
+
+  Record &localRecord();
+  Record *acquireRecord();
+  void releaseRecord(Record &record) noexcept;
+  static void releaseThreadRecord(void *manager, void *record) noexcept;
+  bool tryAdvance() noexcept;
+  std::size_t reclaimBlocks(Block *blocks, Record *owner) noexcept;
+  void freeBag(Record &owner, Bag &bag) noexcept;
+  void collectOrphans() noexcept;
+
+  IAllocator &allocator_;
+  detail::reclaim::DomainLink *const link_;
+
+  alignas(kCacheLineSize) std::atomic<std::uint64_t> epoch_{2};
+  std::atomic<Record *> records_{nullptr};
+
+  // Blocks left behind by exited threads.
+  std::mutex orphanMutex_;
+  Block *orphans_{nullptr};
+  std::atomic<std::size_t> orphanPending_{0};
+};
+
+static_assert(Reclaimer<EpochManager>);
+
+} // namespace dakt::core
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "../platform/Futex.hpp"
+#include "../platform/Simd.hpp"
+
+namespace dakt::core {
+
+enum class EventMode : std::uint8_t {
+  // Stays set once set, releasing every current and future waiter until
+  // reset().
+  OneShot,
+  // Each set() releases one waiter and is consumed by it; sets with no
+  // intervening wait coalesce.
+  AutoReset,
+};
+
+// Futex-backed event. One word holds the signal bit and the number of
+// sleeping waiters, so set() enters the kernel only when someone sleeps and
+// a wait on a set event is a single atomic operation.
+class alignas(kCacheLineSize) Event {
+public:
+  explicit Event(EventMode mode = EventMode::OneShot) noexcept : mode_(mode) {}
+
+  Event(const Event &) = delete;
+  Event &operator=(const Event &) = delete;
+
+  void set() noexcept {
+    const std::uint32_t prev =
+        state_.fetch_or(kSignal, std::memory_order_release);
+    if ((prev & kSignal) != 0 || (prev >> kWaiterShift) == 0) {
+      return;
+    }
+    if (mode_ == EventMode::OneShot) {
+      futexWakeAll(state_);
+    } else {
+      futexWakeOne(state_);
+    }
+  }
+
+  // Clears the signal of a one-shot event, or drops an unconsumed one.
+  void reset() noexcept {
+    state_.fetch_and(~kSignal, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool isSet() const noexcept {
+    return (state_.load(std::memory_order_acquire) & kSignal) != 0;
+  }
+
+  // Returns true if the event was set, consuming the signal in AutoReset
+  // mode. Never blocks.
+  [[nodiscard]] bool tryWait() noexcept {
+    std::uint32_t state = state_.load(std::memory_order_acquire);
+    if (mode_ == EventMode::OneShot) {
+      return (state & kSignal) != 0;
+    }
+    while ((state & kSignal) != 0) {
+      if (state_.compare_exchange_weak(state, state & ~kSignal,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void wait() noexcept {
+    if (tryWait()) {
+      return;
+    }
+    state_.fetch_add(kWaiter, std::memory_order_relaxed);
+    for (;;) {
+      std::uint32_t state = state_.load(std::memory_order_relaxed);
+      if ((state & kSignal) == 0) {
+        futexWait(state_, state);
+      } else if (leave(state)) {
+        return;
+      }
+    }
+  }
+
+  // As wait(), giving up after `timeoutNs`. Returns false on timeout.
+  [[nodiscard]] bool waitFor(std::uint64_t timeoutNs) noexcept {
+    if (tryWait()) {
+      return true;
+    }
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeoutNs);
+    state_.fetch_add(kWaiter, std::memory_order_relaxed);
+    for (;;) {
+      std::uint32_t state = state_.load(std::memory_order_relaxed);
+      if ((state & kSignal) != 0) {
+        if (leave(state)) {
+          return true;
+        }
+        continue;
+      }
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        // A set() may have picked us to wake just now; take its signal
+        // rather than lose it.
+        state = state_.load(std::memory_order_relaxed);
+        for (;;) {
+          if ((state & kSignal) != 0) {
+            if (leave(state)) {
+              return true;
+            }
+            continue;
+          }
+          if (state_.compare_exchange_weak(state, state - kWaiter,
+                                           std::memory_order_relaxed)) {
+            return false;
+          }
+        }
+      }
+      const auto remaining =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+      futexWaitFor(state_, state,
+                   static_cast<std::uint64_t>(remaining.count()));
+    }
+  }
+
+private:
+  static constexpr std::uint32_t kSignal = 1;
+  static constexpr std::uint32_t kWaiterShift = 1;
+  static constexpr std::uint32_t kWaiter = 1u << kWaiterShift;
+
+  // Deregisters a waiter that saw the signal in `state`, consuming the
+  // signal in AutoReset mode. False if `state` was stale.
+  bool leave(std::uint32_t &state) noexcept {
+    const std::uint32_t next =
+        mode_ == EventMode::AutoReset ? (state & ~kSignal) - kWaiter
+                                      : state - kWaiter;
+    return state_.compare_exchange_weak(state, next, std::memory_order_acquire,
+                                        std::memory_order_relaxed);
+  }
+
+  std::atomic<std::uint32_t> state_{0};
+  const EventMode mode_;
+};
+
+} // namespace dakt::core
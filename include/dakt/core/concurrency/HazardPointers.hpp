@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../platform/Simd.hpp"
+#include "Reclaim.hpp"
+
+namespace dakt::core {
+
+// Hazard pointers (Michael, 2004). A reader publishes the one pointer it is
+// about to dereference in a hazard slot and re-checks that the pointer is
+// still reachable; writers retire unlinked nodes into a per-thread list and
+// reclaim, in batches, every node no slot currently names.
+//
+// Compared to EpochManager, protecting a pointer costs a seq_cst store and a
+// reload per pointer rather than once per critical section, but a reader
+// that stalls holds back only the nodes it names. Retired memory stays
+// bounded by roughly 2 x (total slots) per thread plus one node per stalled
+// slot, where a stalled epoch reader holds back everything retired after it
+// pinned.
+//
+// Each thread owns kSlotsPerThread slots in a record it gets on first use;
+// holders beyond that take a whole spare record. A thread scans once its
+// retired list reaches max(64, 2 x total slots), which keeps the cost of a
+// scan amortised over the nodes it frees. Lists left by exited threads pass
+// to the domain and are drained by collect().
+class HazardDomain {
+  struct Record;
+
+public:
+  static constexpr std::size_t kSlotsPerThread = 4;
+
+  explicit HazardDomain(IAllocator &allocator);
+  // Reclaims everything still retired. No holder may be alive.
+  ~HazardDomain();
+
+  HazardDomain(const HazardDomain &) = delete;
+  HazardDomain &operator=(const HazardDomain &) = delete;
+
+  // One hazard slot, owned by the thread that made it and released on
+  // destruction. Not to be handed to another thread.
+  class Holder {
+  public:
+    explicit Holder(HazardDomain &domain);
+    Holder(Holder &&other) noexcept
+        : slot_(std::exchange(other.slot_, nullptr)), record_(other.record_),
+          index_(other.index_), spare_(other.spare_) {}
+    Holder &operator=(Holder &&) = delete;
+    Holder(const Holder &) = delete;
+    ~Holder();
+
+    // Loads `source` and keeps the result protected until the next
+    // protect() or reset(). The slot is published before the re-check, so
+    // a node returned here cannot be reclaimed by a scan that has not seen
+    // it.
+    template <typename T>
+    [[nodiscard]] T *protect(const std::atomic<T *> &source) noexcept {
+      T *ptr = source.load(std::memory_order_relaxed);
+      for (;;) {
+        slot_->store(ptr, std::memory_order_seq_cst);
+        T *current = source.load(std::memory_order_seq_cst);
+        if (current == ptr) {
+          return ptr;
+        }
+        ptr = current;
+      }
+    }
+
+    // Protects `ptr` without validation; the caller must know it is still
+    // reachable, e.g. because another holder protects it.
+    void reset(const void *ptr) noexcept {
+      slot_->store(ptr, std::memory_order_seq_cst);
+    }
+    void reset() noexcept { slot_->store(nullptr, std::memory_order_release); }
+
+  private:
+    std::atomic<const void *> *slot_;
+    Record *record_;
+    std::uint32_t index_;
+    bool spare_;
+  };
+
+  [[nodiscard]] Holder makeHolder() { return Holder(*this); }
+
+  // Schedules `object` to be destroyed and its memory returned to the
+  // domain's allocator once no slot names it. Reclaim functions run inside
+  // retire() and collect() and must not retire into the same domain.
+  template <typename T> void retire(T *object) {
+    retire(object, &detail::reclaim::destroyAndFree<T>, 0);
+  }
+  // Schedules `size` raw bytes at `ptr` to be returned to the allocator.
+  void retire(void *ptr, std::size_t size) {
+    retire(ptr, &detail::reclaim::freeBytes, size);
+  }
+  void retire(void *ptr, ReclaimFn fn, std::size_t arg);
+
+  // Scans now, reclaiming the calling thread's and exited threads'
+  // unprotected nodes.
+  void collect();
+
+  // Retired objects not yet reclaimed, across all threads. Approximate
+  // while other threads retire or collect.
+  [[nodiscard]] std::size_t pendingCount() const noexcept;
+
+  [[nodiscard]] IAllocator &allocator() const noexcept { return allocator_; }
+
+private:
+  // Growable array of retired entries; exited threads' lists are chained
+  // through `next`.
+  struct RetiredList;
+
+  struct alignas(kCacheLineSize) Record {
+    std::atomic<const void *> slots[kSlotsPerThread]{};
+    std::atomic<bool> owned{false};
+    std::atomic<std::size_t> pending{0};
+    Record *next{nullptr};
+    // Owner-thread state.
+    std::uint32_t freeSlots{(1u << kSlotsPerThread) - 1};
+    RetiredList *retired{nullptr};
+    // Sorted hazards seen by the last scan.
+    const void **hazards{nullptr};
+    std::size_t hazardCount{0};
+    std::size_t hazardCapacity{0};
+  };
+
+  Record &localRecord();
+  Record *acquireRecord();
+  void releaseRecord(Record &record) noexcept;
+  static void releaseThreadRecord(void *domain, void *record) noexcept;
+  void scan(Record &record);
+  void growHazards(Record &record);
+  std::size_t reclaimUnprotected(RetiredList &list, const void *const *hazards,
+                                 std::size_t hazardCount) noexcept;
+  RetiredList *growList(RetiredList *list, std::size_t capacity);
+  void freeList(RetiredList *list) noexcept;
+
+  IAllocator &allocator_;
+  detail::reclaim::DomainLink *const link_;
+
+  std::atomic<Record *> records_{nullptr};
+  std::atomic<std::size_t> recordCount_{0};
+
+  // Lists left behind by exited threads.
+  std::mutex orphanMutex_;
+  RetiredList *orphans_{nullptr};
+  std::atomic<std::size_t> orphanPending_{0};
+};
+
+static_assert(Reclaimer<HazardDomain>);
+
+} // namespace dakt::core
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../platform/Simd.hpp"
+#include "../types/Span.hpp"
+
+namespace dakt::core {
+
+// Bounded lock-free queue for any number of producers and consumers, after
+// Dmitry Vyukov's array queue. Every cell carries a sequence number that
+// says whose turn it is: `pos` when free for the producer of position pos,
+// `pos + 1` when holding its value. Producers and consumers claim positions
+// with one CAS on their own counter and then touch only their cell, so the
+// two sides never contend on the same cache line when the queue is neither
+// full nor empty.
+template <typename T> class MpmcQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                std::is_nothrow_destructible_v<T>);
+
+public:
+  // `capacity` is rounded up to a power of two, at least 2.
+  MpmcQueue(IAllocator &allocator, std::size_t capacity)
+      : allocator_(allocator),
+        mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+    cells_ = static_cast<Cell *>(
+        allocator_.allocate((mask_ + 1) * sizeof(Cell), alignof(Cell)));
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      ::new (static_cast<void *>(cells_ + i)) Cell();
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~MpmcQueue() {
+    const std::size_t end = enqueuePos_.load(std::memory_order_relaxed);
+    for (std::size_t i = dequeuePos_.load(std::memory_order_relaxed); i != end;
+         ++i) {
+      cells_[i & mask_].value()->~T();
+    }
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].~Cell();
+    }
+    allocator_.deallocate(cells_, (mask_ + 1) * sizeof(Cell));
+  }
+
+  MpmcQueue(const MpmcQueue &) = delete;
+  MpmcQueue &operator=(const MpmcQueue &) = delete;
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  template <typename... Args> bool tryEmplace(Args &&...args) {
+    std::size_t pos = 0;
+    if (claim(enqueuePos_, 0, 1, pos) == 0) {
+      return false;
+    }
+    Cell &cell = cells_[pos & mask_];
+    ::new (static_cast<void *>(cell.storage)) T(std::forward<Args>(args)...);
+    cell.sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPush(const T &value) { return tryEmplace(value); }
+  bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+
+  // Pushes a prefix of `values` and returns its length. The positions are
+  // claimed together with one CAS, so the batch stays contiguous in queue
+  // order.
+  std::size_t tryPushBatch(Span<const T> values) {
+    std::size_t pos = 0;
+    const std::size_t n = claim(enqueuePos_, 0, values.size(), pos);
+    for (std::size_t i = 0; i < n; ++i) {
+      Cell &cell = cells_[(pos + i) & mask_];
+      ::new (static_cast<void *>(cell.storage)) T(values[i]);
+      cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return n;
+  }
+
+  bool tryPop(T &out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    std::size_t pos = 0;
+    if (claim(dequeuePos_, 1, 1, pos) == 0) {
+      return false;
+    }
+    take(pos, out);
+    return true;
+  }
+
+  // Pops up to out.size() consecutive items and returns how many.
+  std::size_t
+  tryPopBatch(Span<T> out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    std::size_t pos = 0;
+    const std::size_t n = claim(dequeuePos_, 1, out.size(), pos);
+    for (std::size_t i = 0; i < n; ++i) {
+      take(pos + i, out[i]);
+    }
+    return n;
+  }
+
+  [[nodiscard]] std::size_t sizeApprox() const noexcept {
+    const std::size_t head = dequeuePos_.load(std::memory_order_acquire);
+    const std::size_t tail = enqueuePos_.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+  [[nodiscard]] bool emptyApprox() const noexcept { return sizeApprox() == 0; }
+
+private:
+  struct Cell {
+    std::atomic<std::size_t> sequence{0};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *value() noexcept {
+      return std::launder(reinterpret_cast<T *>(storage));
+    }
+  };
+
+  // Claims up to `want` consecutive positions from `counter` whose cells have
+  // sequence pos + offset (0: free for a producer, 1: filled for a consumer).
+  // Returns how many were claimed, starting at `pos`; 0 when full or empty.
+  std::size_t claim(std::atomic<std::size_t> &counter, std::size_t offset,
+                    std::size_t want, std::size_t &pos) noexcept {
+    if (want == 0) {
+      return 0;
+    }
+    pos = counter.load(std::memory_order_relaxed);
+    for (;;) {
+      std::size_t n = 0;
+      bool stale = false;
+      while (n < want && n <= mask_) {
+        const std::size_t seq =
+            cells_[(pos + n) & mask_].sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::intptr_t>(seq) -
+                          static_cast<std::intptr_t>(pos + n + offset);
+        if (diff != 0) {
+          // Behind us: another thread already took this position.
+          stale = diff > 0;
+          break;
+        }
+        ++n;
+      }
+      if (n == 0 && !stale) {
+        return 0;
+      }
+      if (n != 0 && counter.compare_exchange_weak(pos, pos + n,
+                                                  std::memory_order_relaxed,
+                                                  std::memory_order_relaxed)) {
+        return n;
+      }
+      if (n == 0) {
+        pos = counter.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void take(std::size_t pos, T &out) noexcept(
+      std::is_nothrow_move_assignable_v<T>) {
+    Cell &cell = cells_[pos & mask_];
+    T *value = cell.value();
+    out = std::move(*value);
+    value->~T();
+    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  }
+
+  IAllocator &allocator_;
+  Cell *cells_{nullptr};
+  const std::size_t mask_;
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> enqueuePos_{0};
+  alignas(kCacheLineSize) std::atomic<std::size_t> dequeuePos_{0};
+};
+
+} // namespace dakt::core
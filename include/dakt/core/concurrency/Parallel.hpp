@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "../types/Span.hpp"
+#include "ThreadPool.hpp"
+
+// Data-parallel loops over Span on a ThreadPool. The calling thread takes
+// part in the work and the functions return once every element is done.
+// Bodies run concurrently and must not throw.
+namespace dakt::core {
+
+struct ParallelOptions {
+  // Fewest elements handed to the body at once. 0 derives it from the input
+  // size and, unless deterministic, the worker count.
+  std::size_t grain{0};
+  // Split at fixed midpoints down to the grain and combine partial results
+  // in that fixed tree, so parallelReduce gives the same value on every run
+  // even for non-associative operations such as floating-point addition.
+  // The default splits adaptively and combines in completion order.
+  bool deterministic{false};
+};
+
+namespace detail::parallel {
+
+[[nodiscard]] inline std::size_t grainFor(std::size_t n,
+                                          std::size_t workers,
+                                          const ParallelOptions &options) {
+  if (options.grain != 0) {
+    return options.grain;
+  }
+  // Adaptive splitting copes with small grains, so aim for plenty of
+  // chunks; fixed splitting must not depend on the machine.
+  const std::size_t chunks = options.deterministic ? 256 : workers * 32;
+  return std::max<std::size_t>(1, n / chunks);
+}
+
+// Lazy binary splitting (Tzannes et al., PPoPP'10): a task walks its range
+// one grain at a time and gives the upper half of what is left to the pool
+// only while its worker's deque is empty, i.e. when a thief could take it.
+// Splitting thus follows actual demand rather than a fixed depth.
+//
+// Ctx provides start() -> State, step(State&, begin, end) and
+// finish(State&&), called once per task.
+template <typename Ctx>
+void lazySplit(Ctx &ctx, std::size_t begin, std::size_t end) {
+  auto state = ctx.start();
+  while (begin < end) {
+    while (end - begin > ctx.grain && ctx.pool.localQueueEmpty()) {
+      const std::size_t mid = begin + (end - begin) / 2;
+      ctx.group.run([&ctx, mid, end] { lazySplit(ctx, mid, end); });
+      end = mid;
+    }
+    const std::size_t stop = std::min(begin + ctx.grain, end);
+    ctx.step(state, begin, stop);
+    begin = stop;
+  }
+  ctx.finish(std::move(state));
+}
+
+template <typename Body> struct ForContext {
+  struct State {};
+
+  ThreadPool &pool;
+  TaskGroup &group;
+  std::size_t grain;
+  Body &body;
+
+  State start() const noexcept { return {}; }
+  void step(State &, std::size_t begin, std::size_t end) {
+    body(begin, end);
+  }
+  void finish(State &&) const noexcept {}
+};
+
+template <typename Acc, typename Body, typename Combine> struct ReduceContext {
+  ThreadPool &pool;
+  TaskGroup &group;
+  std::size_t grain;
+  Body &body;
+  Combine &combine;
+  const Acc &identity;
+  std::mutex mutex;
+  Acc result;
+
+  Acc start() const { return identity; }
+  void step(Acc &acc, std::size_t begin, std::size_t end) {
+    acc = body(std::move(acc), begin, end);
+  }
+  void finish(Acc &&acc) {
+    const std::lock_guard<std::mutex> lock(mutex);
+    result = combine(std::move(result), std::move(acc));
+  }
+};
+
+// Fixed midpoint splitting down to the grain, one TaskGroup per level.
+template <typename Body> struct FixedForContext {
+  ThreadPool &pool;
+  std::size_t grain;
+  Body &body;
+};
+
+template <typename Body>
+void fixedFor(const FixedForContext<Body> &ctx, std::size_t begin,
+              std::size_t end) {
+  if (end - begin <= ctx.grain) {
+    ctx.body(begin, end);
+    return;
+  }
+  const std::size_t mid = begin + (end - begin) / 2;
+  TaskGroup group(ctx.pool);
+  group.run([&ctx, begin, mid] { fixedFor(ctx, begin, mid); });
+  fixedFor(ctx, mid, end);
+  group.wait();
+}
+
+template <typename Acc, typename Body, typename Combine>
+struct FixedReduceContext {
+  ThreadPool &pool;
+  std::size_t grain;
+  Body &body;
+  Combine &combine;
+  const Acc &identity;
+};
+
+template <typename Acc, typename Body, typename Combine>
+Acc fixedReduce(const FixedReduceContext<Acc, Body, Combine> &ctx,
+                std::size_t begin, std::size_t end) {
+  if (end - begin <= ctx.grain) {
+    return ctx.body(Acc(ctx.identity), begin, end);
+  }
+  const std::size_t mid = begin + (end - begin) / 2;
+  Acc left(ctx.identity);
+  TaskGroup group(ctx.pool);
+  group.run(
+      [&ctx, &left, begin, mid] { left = fixedReduce(ctx, begin, mid); });
+  Acc right = fixedReduce(ctx, mid, end);
+  group.wait();
+  return ctx.combine(std::move(left), std::move(right));
+}
+
+// Runs body(begin, end) over disjoint subranges covering [0, n).
+template <typename Body>
+void forRange(ThreadPool &pool, std::size_t n, Body &body,
+              const ParallelOptions &options) {
+  const std::size_t grain = grainFor(n, pool.workerCount(), options);
+  if (n <= grain) {
+    if (n != 0) {
+      body(std::size_t{0}, n);
+    }
+    return;
+  }
+  if (options.deterministic) {
+    fixedFor(FixedForContext<Body>{pool, grain, body}, 0, n);
+    return;
+  }
+  TaskGroup group(pool);
+  ForContext<Body> ctx{pool, group, grain, body};
+  lazySplit(ctx, 0, n);
+  group.wait();
+}
+
+// Folds body(acc, begin, end) over subranges and combines the partials.
+template <typename Acc, typename Body, typename Combine>
+Acc reduceRange(ThreadPool &pool, std::size_t n, const Acc &identity,
+                Body &body, Combine &combine, const ParallelOptions &options) {
+  const std::size_t grain = grainFor(n, pool.workerCount(), options);
+  if (n <= grain) {
+    return body(Acc(identity), 0, n);
+  }
+  if (options.deterministic) {
+    return fixedReduce(
+        FixedReduceContext<Acc, Body, Combine>{pool, grain, body, combine,
+                                               identity},
+        0, n);
+  }
+  TaskGroup group(pool);
+  ReduceContext<Acc, Body, Combine> ctx{pool,    group,    grain, body,
+                                        combine, identity, {},    identity};
+  lazySplit(ctx, 0, n);
+  group.wait();
+  return std::move(ctx.result);
+}
+
+} // namespace detail::parallel
+
+// Calls f(chunk) for disjoint chunks of `items` that together cover it.
+template <typename T, typename F>
+void parallelForChunks(ThreadPool &pool, Span<T> items, F &&f,
+                       ParallelOptions options = {}) {
+  auto body = [&items, &f](std::size_t begin, std::size_t end) {
+    f(items.subspan(begin, end - begin));
+  };
+  detail::parallel::forRange(pool, items.size(), body, options);
+}
+
+// Calls f(item) once for every element of `items`.
+template <typename T, typename F>
+void parallelFor(ThreadPool &pool, Span<T> items, F &&f,
+                 ParallelOptions options = {}) {
+  auto body = [&items, &f](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      f(items[i]);
+    }
+  };
+  detail::parallel::forRange(pool, items.size(), body, options);
+}
+
+// Folds every element into a copy of `identity` with fold(acc, item) -> acc
+// and merges the partial results with combine(acc, acc) -> acc. Unless
+// options.deterministic is set, combine must be associative and commutative.
+template <typename T, typename Acc, typename Fold, typename Combine>
+Acc parallelReduce(ThreadPool &pool, Span<T> items, Acc identity, Fold &&fold,
+                   Combine &&combine, ParallelOptions options = {}) {
+  auto body = [&items, &fold](Acc acc, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      acc = fold(std::move(acc), items[i]);
+    }
+    return acc;
+  };
+  return detail::parallel::reduceRange(pool, items.size(), identity, body,
+                                       combine, options);
+}
+
+} // namespace dakt::core
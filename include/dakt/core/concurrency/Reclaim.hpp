@@ -0,0 +1,71 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "../interfaces/IAllocator.hpp"
+
+namespace dakt::core {
+
+// Frees retired memory: runs `fn(allocator, ptr, arg)` once no reader can
+// still hold `ptr`.
+using ReclaimFn = void (*)(IAllocator &allocator, void *ptr,
+                           std::size_t arg) noexcept;
+
+// Retire interface shared by EpochManager and HazardDomain, so a structure
+// can be written once against either scheme.
+template <typename R>
+concept Reclaimer = requires(R &r, int *object, void *ptr, std::size_t size,
+                             ReclaimFn fn) {
+  r.retire(object);
+  r.retire(ptr, size);
+  r.retire(ptr, fn, size);
+  r.collect();
+  { r.pendingCount() } -> std::convertible_to<std::size_t>;
+};
+
+namespace detail::reclaim {
+
+struct Retired {
+  void *ptr;
+  ReclaimFn fn;
+  std::size_t arg;
+
+  void reclaim(IAllocator &allocator) const noexcept { fn(allocator, ptr, arg); }
+};
+
+template <typename T>
+void destroyAndFree(IAllocator &allocator, void *ptr, std::size_t) noexcept {
+  static_cast<T *>(ptr)->~T();
+  allocator.deallocate(ptr, sizeof(T));
+}
+
+inline void freeBytes(IAllocator &allocator, void *ptr,
+                      std::size_t size) noexcept {
+  allocator.deallocate(ptr, size);
+}
+
+// Per-thread records of reclamation domains. A thread looks up the record it
+// holds in a domain; at thread exit every record is handed back through its
+// domain's release function, unless the domain was destroyed first.
+//
+// Each domain owns a DomainLink, reference-counted by the domain and by every
+// thread holding a record in it. The domain closes the link in its
+// destructor; the link outlives both sides, so an exiting thread can always
+// check whether its domain is still alive.
+using ReleaseRecordFn = void (*)(void *domain, void *record) noexcept;
+
+struct DomainLink;
+
+[[nodiscard]] DomainLink *openDomainLink(void *domain,
+                                         ReleaseRecordFn release);
+// Waits for any exit-time release running on the domain, then detaches it
+// from every thread.
+void closeDomainLink(DomainLink *link) noexcept;
+[[nodiscard]] void *findThreadRecord(const DomainLink *link) noexcept;
+void setThreadRecord(DomainLink *link, void *record);
+
+} // namespace detail::reclaim
+
+} // namespace dakt::core
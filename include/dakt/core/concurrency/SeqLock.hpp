@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../platform/Futex.hpp"
+#include "../platform/Simd.hpp"
+
+namespace dakt::core {
+
+// Sequence lock for small, read-mostly values. Readers never write shared
+// memory: they copy the value between two reads of a sequence counter and
+// retry if a writer ran in between (the counter was odd, or changed).
+// Writers take the counter to odd with a CAS, so they exclude each other
+// and never wait for readers.
+//
+// The value is kept as atomic 64-bit words rather than a plain T, which
+// makes the reader's racy copy well-defined (Boehm, "Can Seqlocks Get Along
+// With Programming Language Memory Models?", 2012). T should be a few cache
+// lines at most; readers retry the whole copy under write pressure.
+template <typename T> class alignas(kCacheLineSize) SeqLock {
+  static_assert(std::is_trivially_copyable_v<T> &&
+                std::is_default_constructible_v<T>);
+
+public:
+  SeqLock() noexcept : SeqLock(T{}) {}
+  explicit SeqLock(const T &value) noexcept { writeWords(value); }
+
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  [[nodiscard]] T load() const noexcept {
+    T out;
+    while (!tryLoad(out)) {
+      cpuRelax();
+    }
+    return out;
+  }
+
+  // One read attempt; false if it overlapped a write.
+  [[nodiscard]] bool tryLoad(T &out) const noexcept {
+    const std::uint32_t before = sequence_.load(std::memory_order_acquire);
+    if ((before & 1) != 0) {
+      return false;
+    }
+    // Acquire loads keep the re-check after them, and a word written by a
+    // concurrent writer carries its odd counter along.
+    std::uint64_t words[kWords];
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_acquire);
+    }
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(&out, words, sizeof(T));
+    return true;
+  }
+
+  void store(const T &value) noexcept {
+    const std::uint32_t sequence = beginWrite();
+    writeWords(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Applies `f(T&)` to the current value under the write lock. `f` runs
+  // while readers spin, so keep it short.
+  template <typename F> void update(F &&f) {
+    const std::uint32_t sequence = beginWrite();
+    T value;
+    std::uint64_t words[kWords];
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&value, words, sizeof(T));
+    f(value);
+    writeWords(value);
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Even while no write is in progress; the number of completed writes is
+  // sequence() / 2.
+  [[nodiscard]] std::uint32_t sequence() const noexcept {
+    return sequence_.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t kWords =
+      (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+  // Takes the counter from even to odd; returns the even value.
+  std::uint32_t beginWrite() noexcept {
+    std::uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    for (;;) {
+      if ((sequence & 1) == 0 &&
+          sequence_.compare_exchange_weak(sequence, sequence + 1,
+                                          std::memory_order_acquire,
+                                          std::memory_order_relaxed)) {
+        return sequence;
+      }
+      cpuRelax();
+      sequence = sequence_.load(std::memory_order_relaxed);
+    }
+  }
+
+  void writeWords(const T &value) noexcept {
+    std::uint64_t words[kWords] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (std::size_t i = 0; i < kWords; ++i) {
+      words_[i].store(words[i], std::memory_order_release);
+    }
+  }
+
+  std::atomic<std::uint32_t> sequence_{0};
+  std::atomic<std::uint64_t> words_[kWords];
+};
+
+} // namespace dakt::core
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../platform/Simd.hpp"
+#include "../types/Span.hpp"
+
+namespace dakt::core {
+
+// Bounded wait-free queue for exactly one producer and one consumer thread.
+// Indices grow monotonically and are masked into a power-of-two ring, so all
+// slots are usable. Each side keeps a private copy of the other side's index
+// and reloads it only when the ring looks full (or empty), which keeps the
+// shared cache lines out of the common path.
+template <typename T> class SpscQueue {
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                std::is_nothrow_destructible_v<T>);
+
+public:
+  // `capacity` is rounded up to a power of two.
+  SpscQueue(IAllocator &allocator, std::size_t capacity)
+      : allocator_(allocator),
+        mask_(std::bit_ceil(std::max<std::size_t>(capacity, 1)) - 1) {
+    slots_ = static_cast<T *>(
+        allocator_.allocate((mask_ + 1) * sizeof(T), alignof(T)));
+  }
+
+  ~SpscQueue() {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    for (std::size_t i = head_.load(std::memory_order_relaxed); i != tail;
+         ++i) {
+      slots_[i & mask_].~T();
+    }
+    allocator_.deallocate(slots_, (mask_ + 1) * sizeof(T));
+  }
+
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+  // Producer side.
+  template <typename... Args> bool tryEmplace(Args &&...args) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cachedHead_ > mask_) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      if (tail - cachedHead_ > mask_) {
+        return false;
+      }
+    }
+    ::new (static_cast<void *>(slots_ + (tail & mask_)))
+        T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool tryPush(const T &value) { return tryEmplace(value); }
+  bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+
+  // Pushes a prefix of `values` and returns its length, publishing it with a
+  // single store.
+  std::size_t tryPushBatch(Span<const T> values) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    std::size_t room = capacity() - (tail - cachedHead_);
+    if (room < values.size()) {
+      cachedHead_ = head_.load(std::memory_order_acquire);
+      room = capacity() - (tail - cachedHead_);
+    }
+    const std::size_t n = std::min(room, values.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      ::new (static_cast<void *>(slots_ + ((tail + i) & mask_))) T(values[i]);
+    }
+    if (n != 0) {
+      tail_.store(tail + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  // Consumer side.
+  bool tryPop(T &out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == cachedTail_) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      if (head == cachedTail_) {
+        return false;
+      }
+    }
+    T &slot = slots_[head & mask_];
+    out = std::move(slot);
+    slot.~T();
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pops up to out.size() items into `out` and returns how many.
+  std::size_t
+  tryPopBatch(Span<T> out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    std::size_t ready = cachedTail_ - head;
+    if (ready < out.size()) {
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+      ready = cachedTail_ - head;
+    }
+    const std::size_t n = std::min(ready, out.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      T &slot = slots_[(head + i) & mask_];
+      out[i] = std::move(slot);
+      slot.~T();
+    }
+    if (n != 0) {
+      head_.store(head + n, std::memory_order_release);
+    }
+    return n;
+  }
+
+  // Either side; exact only when the other side is idle.
+  [[nodiscard]] std::size_t sizeApprox() const noexcept {
+    const std::size_t head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+  [[nodiscard]] bool emptyApprox() const noexcept { return sizeApprox() == 0; }
+
+private:
+  IAllocator &allocator_;
+  T *slots_{nullptr};
+  const std::size_t mask_;
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+  std::size_t cachedTail_{0}; // consumer's view of tail_
+
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+  std::size_t cachedHead_{0}; // producer's view of head_
+};
+
+} // namespace dakt::core
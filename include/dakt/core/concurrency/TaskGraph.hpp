@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../types/ErrorCode.hpp"
+#include "../types/Result.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+#include "ThreadPool.hpp"
+
+namespace dakt::core {
+
+enum class TaskGraphError : std::uint8_t {
+  UnknownNode, // a dependency names a node that was never added
+  Cycle,       // the dependencies do not form a DAG
+  NotCompiled  // run() before compile(), or after the graph changed
+};
+
+[[nodiscard]] constexpr ErrorCode toErrorCode(TaskGraphError e) noexcept {
+  return ErrorCode(ErrorCategory::Task, e);
+}
+
+// Timing of one node in the most recent run, relative to the start of that
+// run.
+struct TaskTiming {
+  std::uint64_t startNs{0};
+  std::uint64_t durationNs{0};
+  // Pool worker that ran the node, or ThreadPool::npos for the thread that
+  // called run().
+  std::size_t worker{ThreadPool::npos};
+};
+
+// Fixed DAG of tasks that is declared once, compiled into a flat schedule and
+// then executed repeatedly, e.g. once per frame. A run resets per-node
+// dependency counters, submits the roots, and each finished node releases its
+// successors: the first ready one continues on the same thread, the others go
+// to the pool. Nothing is allocated after compile().
+//
+// Node work is invoked once per run and kept between runs. A graph must not
+// be run concurrently with itself.
+class TaskGraph {
+public:
+  using NodeId = std::uint32_t;
+
+  TaskGraph() = default;
+  ~TaskGraph();
+
+  TaskGraph(const TaskGraph &) = delete;
+  TaskGraph &operator=(const TaskGraph &) = delete;
+
+  // Adds a node that runs `work` (which may be empty, for a pure join point)
+  // after every node in `dependencies`.
+  NodeId addNode(StringView name, Task work,
+                 std::initializer_list<NodeId> dependencies = {});
+  NodeId addNode(StringView name, Task work, Span<const NodeId> dependencies);
+
+  // Makes `after` wait for `before`. Unknown ids make compile() fail.
+  void addDependency(NodeId before, NodeId after);
+
+  // Checks the graph and builds the schedule. Must be called again after the
+  // graph changes.
+  Result<void, TaskGraphError> compile();
+
+  // Executes every node once and returns when all have finished. The calling
+  // thread runs nodes too while it waits.
+  Result<void, TaskGraphError> run(ThreadPool &pool);
+
+  [[nodiscard]] std::size_t nodeCount() const noexcept {
+    return nodes_.size();
+  }
+  [[nodiscard]] bool compiled() const noexcept { return compiled_; }
+  [[nodiscard]] StringView name(NodeId node) const {
+    return StringView(nodes_[node].name);
+  }
+
+  // Per-node timings of the last run, indexed by NodeId.
+  [[nodiscard]] Span<const TaskTiming> timings() const noexcept {
+    return Span<const TaskTiming>(timings_.data(), timings_.size());
+  }
+  // Wall time of the last run.
+  [[nodiscard]] std::uint64_t lastRunNs() const noexcept {
+    return lastRunNs_;
+  }
+
+private:
+  struct Node {
+    std::string name;
+    Task work;
+    std::vector<NodeId> successors;
+  };
+
+  void execute(TaskGroup &group, NodeId node) noexcept;
+
+  std::vector<Node> nodes_;
+  bool compiled_{false};
+  bool unknownDependency_{false};
+
+  // Compiled schedule: successors in CSR form, initial dependency counts and
+  // the nodes that start each run.
+  std::vector<std::uint32_t> successorOffsets_;
+  std::vector<NodeId> successorList_;
+  std::vector<std::uint32_t> dependencyCounts_;
+  std::vector<NodeId> roots_;
+
+  std::unique_ptr<std::atomic<std::uint32_t>[]> pending_;
+  std::vector<TaskTiming> timings_;
+  std::uint64_t runStartNs_{0};
+  std::uint64_t lastRunNs_{0};
+};
+
+} // namespace dakt::core
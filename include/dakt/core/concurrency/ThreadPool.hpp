@@ -0,0 +1,248 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../platform/CpuTopology.hpp"
+#include "../platform/Futex.hpp"
+#include "../types/StringView.hpp"
+
+namespace dakt::core {
+
+// Move-only `void()` callable stored inline. Unlike std::function it never
+// allocates: callables that do not fit are rejected at compile time, so
+// capture large state by reference or pointer. Invocation is noexcept; a
+// callable that throws terminates the process.
+class Task {
+public:
+  static constexpr std::size_t kInlineSize = 48;
+
+  template <typename F>
+  static constexpr bool fitsInline =
+      sizeof(F) <= kInlineSize && alignof(F) <= alignof(std::max_align_t) &&
+      std::is_nothrow_move_constructible_v<F>;
+
+  Task() noexcept = default;
+
+  template <typename F>
+    requires(!std::is_same_v<std::remove_cvref_t<F>, Task> &&
+             std::is_invocable_r_v<void, std::remove_cvref_t<F> &>)
+  Task(F &&f) noexcept(
+      std::is_nothrow_constructible_v<std::remove_cvref_t<F>, F &&>) {
+    using Fn = std::remove_cvref_t<F>;
+    static_assert(fitsInline<Fn>,
+                  "callable too large for Task; capture by reference");
+    ::new (static_cast<void *>(storage_)) Fn(std::forward<F>(f));
+    ops_ = &kOps<Fn>;
+  }
+
+  Task(Task &&other) noexcept : ops_(std::exchange(other.ops_, nullptr)) {
+    if (ops_ != nullptr) {
+      ops_->relocate(storage_, other.storage_);
+    }
+  }
+
+  Task &operator=(Task &&other) noexcept {
+    if (this != &other) {
+      reset();
+      ops_ = std::exchange(other.ops_, nullptr);
+      if (ops_ != nullptr) {
+        ops_->relocate(storage_, other.storage_);
+      }
+    }
+    return *this;
+  }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  ~Task() { reset(); }
+
+  void operator()() noexcept { ops_->invoke(storage_); }
+
+  [[nodiscard]] explicit operator bool() const noexcept {
+    return ops_ != nullptr;
+  }
+
+  void reset() noexcept {
+    if (ops_ != nullptr) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+private:
+  struct Ops {
+    void (*invoke)(void *) noexcept;
+    // Move-constructs into dst and destroys src.
+    void (*relocate)(void *dst, void *src) noexcept;
+    void (*destroy)(void *) noexcept;
+  };
+
+  template <typename Fn>
+  static constexpr Ops kOps{
+      [](void *p) noexcept { (*static_cast<Fn *>(p))(); },
+      [](void *dst, void *src) noexcept {
+        ::new (dst) Fn(std::move(*static_cast<Fn *>(src)));
+        static_cast<Fn *>(src)->~Fn();
+      },
+      [](void *p) noexcept { static_cast<Fn *>(p)->~Fn(); },
+  };
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+  const Ops *ops_{nullptr};
+};
+
+enum class WorkerPlacement : std::uint8_t {
+  // Workers are not pinned; the OS places them.
+  None,
+  // One worker per physical core, pinned to that core's SMT siblings.
+  PhysicalCores,
+  // One worker per hardware thread, pinned to it.
+  LogicalCpus,
+};
+
+struct ThreadPoolOptions {
+  // 0: one worker per place for pinned placements, otherwise
+  // std::thread::hardware_concurrency(). Extra workers wrap around the
+  // places.
+  std::size_t workerCount{0};
+  WorkerPlacement placement{WorkerPlacement::None};
+  // Machine to place workers on; when null, CpuTopology::detect() as seen
+  // by the constructing thread.
+  const CpuTopology *topology{nullptr};
+  // Workers are named "<name>-<index>", cut to the OS limit. Empty leaves
+  // the names alone.
+  StringView name{"dakt-pool", 9};
+};
+
+// Shared work-stealing pool. Each worker owns a Chase-Lev deque: it pushes
+// and pops at the bottom (LIFO, cache-warm), idle workers steal from the top
+// of a random victim. Threads outside the pool submit through a single
+// injection queue. Idle workers spin briefly and then sleep on a futex until
+// new work is submitted.
+//
+// Tasks live in fixed-size nodes recycled through per-worker free lists, so
+// steady-state submission does not allocate; node slabs and deque buffers
+// come from the IAllocator.
+//
+// Pinned placements follow the order of CpuTopology::cores(), so the first
+// workers fill one L3 domain before the next, and a thief tries the workers
+// that share its L3 before the rest. Pinning is best effort: a worker whose
+// affinity call fails (e.g. a CPU outside the process's cpuset) runs
+// unpinned.
+class ThreadPool {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  // workerCount == 0 uses std::thread::hardware_concurrency().
+  explicit ThreadPool(IAllocator &allocator, std::size_t workerCount = 0)
+      : ThreadPool(allocator, ThreadPoolOptions{workerCount}) {}
+  ThreadPool(IAllocator &allocator, const ThreadPoolOptions &options);
+  // Runs every task still queued, then joins the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  [[nodiscard]] std::size_t workerCount() const noexcept {
+    return workerCount_;
+  }
+
+  // Index of the calling thread among this pool's workers, or npos.
+  [[nodiscard]] std::size_t currentWorkerIndex() const noexcept;
+
+  template <typename F> void submit(F &&f) {
+    submit(Task(std::forward<F>(f)));
+  }
+  void submit(Task task);
+
+  // True when the calling worker has nothing queued locally, i.e. idle
+  // workers would find nothing to steal from it. Always true off the pool.
+  // Adaptive algorithms split work only while this holds.
+  [[nodiscard]] bool localQueueEmpty() const noexcept;
+
+  // Runs one queued task on the calling thread, if any is available. Lets
+  // threads that wait on pool work help instead of blocking.
+  bool runPendingTask();
+
+private:
+  struct Node;
+  struct NodeCache;
+  struct Worker;
+
+  Node *acquireNode(NodeCache &cache);
+  void releaseNode(Node *node, NodeCache *local) noexcept;
+  void run(Node *node, NodeCache *local) noexcept;
+  Node *popInjected() noexcept;
+  void place(WorkerPlacement placement, const CpuTopology &topology);
+  Node *steal(std::size_t self, std::uint64_t &rng) noexcept;
+  Node *findWork(Worker *self) noexcept;
+  void notify() noexcept;
+  void workerLoop(std::size_t index);
+
+  IAllocator &allocator_;
+  std::size_t workerCount_{0};
+  Worker *workers_{nullptr};
+  // Worker indices grouped by L3 domain, and the CPUs each worker is
+  // pinned to; both empty when unpinned.
+  std::uint32_t *stealOrder_{nullptr};
+  std::uint32_t *cpuIds_{nullptr};
+  std::size_t cpuIdCount_{0};
+
+  std::mutex injectMutex_;
+  Node *injectHead_{nullptr};
+  Node *injectTail_{nullptr};
+  std::atomic<std::size_t> injectCount_{0};
+  std::unique_ptr<NodeCache> externalCache_;
+
+  alignas(64) std::atomic<std::uint32_t> wakeSeq_{0};
+  std::atomic<std::uint32_t> sleepers_{0};
+  std::atomic<bool> stopping_{false};
+};
+
+// Fork-join scope: run() submits tasks to the pool and wait() returns once
+// all of them finished. Waiting helps by running queued tasks, so nested
+// groups inside pool tasks do not deadlock.
+class TaskGroup {
+public:
+  explicit TaskGroup(ThreadPool &pool) noexcept : pool_(pool) {}
+  ~TaskGroup() { wait(); }
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  // The callable shares the Task budget with one pointer.
+  template <typename F> void run(F &&f) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    pool_.submit([this, fn = std::forward<F>(f)]() mutable noexcept {
+      fn();
+      finish();
+    });
+  }
+
+  void wait() noexcept;
+
+  [[nodiscard]] ThreadPool &pool() const noexcept { return pool_; }
+
+private:
+  // The waiter may return and destroy the group as soon as the count hits
+  // zero; the wake only uses the address as a key and never reads it.
+  void finish() noexcept {
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      futexWakeAll(pending_);
+    }
+  }
+
+  ThreadPool &pool_;
+  std::atomic<std::uint32_t> pending_{0};
+};
+
+} // namespace dakt::core
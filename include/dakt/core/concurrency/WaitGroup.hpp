@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "../platform/Futex.hpp"
+#include "../platform/Simd.hpp"
+
+namespace dakt::core {
+
+// Counts outstanding work; wait() blocks until the count drops to zero. Like
+// TaskGroup but without a pool: any thread may add() or done(), and any
+// number of threads may wait.
+//
+// The count and a "someone sleeps" bit share one futex word, so done()
+// enters the kernel only for the last decrement and only if a waiter is
+// asleep. add() must not race with a wait() that may see the count reach
+// zero; reuse the group only after every wait() returned.
+class alignas(kCacheLineSize) WaitGroup {
+public:
+  explicit WaitGroup(std::uint32_t count = 0) noexcept
+      : state_(count * kOne) {}
+
+  WaitGroup(const WaitGroup &) = delete;
+  WaitGroup &operator=(const WaitGroup &) = delete;
+
+  void add(std::uint32_t n = 1) noexcept {
+    state_.fetch_add(n * kOne, std::memory_order_relaxed);
+  }
+
+  // The waiter may return and destroy the group as soon as the count hits
+  // zero; the wake only uses the address as a key and never reads it.
+  void done() noexcept {
+    if (state_.fetch_sub(kOne, std::memory_order_acq_rel) ==
+        (kOne | kSleepers)) {
+      futexWakeAll(state_);
+    }
+  }
+
+  void wait() noexcept {
+    std::uint32_t state = state_.load(std::memory_order_acquire);
+    while (state >= kOne) {
+      if (mark(state)) {
+        futexWait(state_, state | kSleepers);
+      }
+      state = state_.load(std::memory_order_acquire);
+    }
+    clearMark(state);
+  }
+
+  // As wait(), giving up after `timeoutNs`. Returns false on timeout.
+  [[nodiscard]] bool waitFor(std::uint64_t timeoutNs) noexcept {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::nanoseconds(timeoutNs);
+    std::uint32_t state = state_.load(std::memory_order_acquire);
+    while (state >= kOne) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        return false;
+      }
+      if (mark(state)) {
+        const auto remaining =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now);
+        futexWaitFor(state_, state | kSleepers,
+                     static_cast<std::uint64_t>(remaining.count()));
+      }
+      state = state_.load(std::memory_order_acquire);
+    }
+    clearMark(state);
+    return true;
+  }
+
+  [[nodiscard]] std::uint32_t count() const noexcept {
+    return state_.load(std::memory_order_acquire) / kOne;
+  }
+
+private:
+  static constexpr std::uint32_t kSleepers = 1;
+  static constexpr std::uint32_t kOne = 2;
+
+  // Sets the sleepers bit so the last done() wakes us. False if `state` was
+  // stale.
+  bool mark(std::uint32_t &state) noexcept {
+    return (state & kSleepers) != 0 ||
+           state_.compare_exchange_weak(state, state | kSleepers,
+                                        std::memory_order_relaxed);
+  }
+
+  // Drops the bit left behind by the last wake, sparing the next round's
+  // final done() a system call. Harmless if a new add() got there first.
+  void clearMark(std::uint32_t state) noexcept {
+    if (state == kSleepers) {
+      state_.compare_exchange_strong(state, 0, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<std::uint32_t> state_;
+};
+
+} // namespace dakt::core
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+// Fast non-cryptographic hashing (wyhash final4 construction). The same
+// constexpr code runs at compile time and at run time, and input is always
+// read little-endian, so a hash computed in a constant expression matches the
+// one computed at run time on any platform.
+namespace dakt::core {
+
+namespace detail::hash {
+
+inline constexpr std::uint64_t kSecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+    0x4d5a2da51de1aa47ull};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using Uint128 = unsigned __int128;
+#endif
+
+constexpr void mum(std::uint64_t &a, std::uint64_t &b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  const Uint128 r = static_cast<Uint128>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64);
+#else
+  const std::uint64_t ha = a >> 32;
+  const std::uint64_t hb = b >> 32;
+  const std::uint64_t la = static_cast<std::uint32_t>(a);
+  const std::uint64_t lb = static_cast<std::uint32_t>(b);
+  const std::uint64_t rh = ha * hb;
+  const std::uint64_t rm0 = ha * lb;
+  const std::uint64_t rm1 = hb * la;
+  const std::uint64_t rl = la * lb;
+  const std::uint64_t t = rl + (rm0 << 32);
+  std::uint64_t carry = t < rl ? 1 : 0;
+  const std::uint64_t lo = t + (rm1 << 32);
+  carry += lo < t ? 1 : 0;
+  const std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+  a = lo;
+  b = hi;
+#endif
+}
+
+constexpr std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept {
+  mum(a, b);
+  return a ^ b;
+}
+
+template <typename B> constexpr std::uint64_t byteAt(const B *p) noexcept {
+  return static_cast<std::uint64_t>(static_cast<unsigned char>(p[0]));
+}
+
+template <typename B, std::size_t N>
+constexpr std::uint64_t readLe(const B *p) noexcept {
+  if consteval {
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      v |= byteAt(p + i) << (8 * i);
+    }
+    return v;
+  } else {
+    std::conditional_t<N == 8, std::uint64_t, std::uint32_t> v;
+    std::memcpy(&v, p, N);
+    if constexpr (std::endian::native == std::endian::big) {
+      v = std::byteswap(v);
+    }
+    return v;
+  }
+}
+
+template <typename B>
+constexpr std::uint64_t r8(const B *p) noexcept {
+  return readLe<B, 8>(p);
+}
+template <typename B>
+constexpr std::uint64_t r4(const B *p) noexcept {
+  return readLe<B, 4>(p);
+}
+template <typename B>
+constexpr std::uint64_t r3(const B *p, std::size_t k) noexcept {
+  return (byteAt(p) << 16) | (byteAt(p + (k >> 1)) << 8) | byteAt(p + k - 1);
+}
+
+template <typename B>
+constexpr std::uint64_t wyhash(const B *p, std::size_t len,
+                               std::uint64_t seed) noexcept {
+  const std::uint64_t *s = kSecret;
+  seed ^= mix(seed ^ s[0], s[1]);
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (len <= 16) {
+    if (len >= 4) {
+      const std::size_t off = (len >> 3) << 2;
+      a = (r4(p) << 32) | r4(p + off);
+      b = (r4(p + len - 4) << 32) | r4(p + len - 4 - off);
+    } else if (len > 0) {
+      a = r3(p, len);
+    }
+  } else {
+    std::size_t i = len;
+    if (i >= 48) {
+      std::uint64_t see1 = seed;
+      std::uint64_t see2 = seed;
+      do {
+        seed = mix(r8(p) ^ s[1], r8(p + 8) ^ seed);
+        see1 = mix(r8(p + 16) ^ s[2], r8(p + 24) ^ see1);
+        see2 = mix(r8(p + 32) ^ s[3], r8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i >= 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = mix(r8(p) ^ s[1], r8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = r8(p + i - 16);
+    b = r8(p + i - 8);
+  }
+  a ^= s[1];
+  b ^= seed;
+  mum(a, b);
+  return mix(a ^ s[0] ^ len, b ^ s[1]);
+}
+
+} // namespace detail::hash
+
+[[nodiscard]] constexpr std::uint64_t hash(StringView s,
+                                           std::uint64_t seed = 0) noexcept {
+  return detail::hash::wyhash(s.data(), s.size(), seed);
+}
+
+[[nodiscard]] constexpr std::uint64_t
+hashBytes(Span<const std::byte> data, std::uint64_t seed = 0) noexcept {
+  return detail::hash::wyhash(data.data(), data.size(), seed);
+}
+
+// Mixes two 64-bit values, e.g. to combine field hashes.
+[[nodiscard]] constexpr std::uint64_t hashCombine(std::uint64_t a,
+                                                  std::uint64_t b) noexcept {
+  return detail::hash::mix(a ^ detail::hash::kSecret[0],
+                           b ^ detail::hash::kSecret[1]);
+}
+
+// Transparent hasher for unordered containers keyed by strings.
+struct StringHash {
+  using is_transparent = void;
+
+  [[nodiscard]] std::size_t operator()(StringView s) const noexcept {
+    return static_cast<std::size_t>(hash(s));
+  }
+  [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept {
+    return static_cast<std::size_t>(hash(StringView(s.data(), s.size())));
+  }
+  [[nodiscard]] std::size_t operator()(const std::string &s) const noexcept {
+    return static_cast<std::size_t>(hash(StringView(s)));
+  }
+};
+
+namespace literals {
+
+consteval std::uint64_t operator""_hash(const char *str, std::size_t len) {
+  return hash(StringView(str, len));
+}
+
+} // namespace literals
+
+} // namespace dakt::core
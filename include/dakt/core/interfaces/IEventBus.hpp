@@ -4,13 +4,21 @@
 #include <cstdint>
 #include <functional>
 
+#include "../hash/Hash.hpp"
 #include "../types/Span.hpp"
+#include "../types/StringView.hpp"
 
 namespace dakt::core {
 
 using EventId = std::uint64_t;
 using SubscriptionToken = std::uint64_t;
 
+// Stable id for a named event; identical whether evaluated at compile time or
+// at run time.
+[[nodiscard]] constexpr EventId makeEventId(StringView name) noexcept {
+  return hash(name);
+}
+
 struct IEventBus {
   virtual ~IEventBus() = default;
 
@@ -3,18 +3,12 @@
 #include <string>
 #include <vector>
 
+#include "../types/Rect.hpp"
 #include "../types/Result.hpp"
 #include "../types/StringView.hpp"
 
 namespace dakt::core {
 
-struct Rect {
-  int x{};
-  int y{};
-  int width{};
-  int height{};
-};
-
 struct IRegionProvider {
   virtual ~IRegionProvider() = default;
 
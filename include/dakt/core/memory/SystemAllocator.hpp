@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <new>
 
@@ -9,14 +10,32 @@
 
 namespace dakt::core {
 
+// Blocks come from operator new at one fixed alignment and go back through
+// the matching delete, over-allocated so the result can be aligned to any
+// power of two. The word before the result holds its distance from the start
+// of the block, which is all deallocate() needs.
 struct SystemAllocator : IAllocator {
   void *allocate(std::size_t size,
                  std::size_t alignment = alignof(std::max_align_t)) override {
-    return ::operator new(size, std::align_val_t{alignment});
+    const std::size_t align = std::max(alignment, kBaseAlignment);
+    auto *raw = static_cast<unsigned char *>(
+        ::operator new(size + align, std::align_val_t{kBaseAlignment}));
+    // raw is kBaseAlignment-aligned, so at most `align` bytes are skipped.
+    const auto start = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t user =
+        (start + sizeof(std::size_t) + align - 1) & ~(align - 1);
+    auto *ptr = raw + (user - start);
+    reinterpret_cast<std::size_t *>(ptr)[-1] = user - start;
+    return ptr;
   }
 
-  void deallocate(void *ptr, std::size_t size) override {
-    ::operator delete(ptr, size);
+  void deallocate(void *ptr, std::size_t /*size*/) override {
+    if (ptr == nullptr) {
+      return;
+    }
+    auto *user = static_cast<unsigned char *>(ptr);
+    const std::size_t offset = reinterpret_cast<std::size_t *>(user)[-1];
+    ::operator delete(user - offset, std::align_val_t{kBaseAlignment});
   }
 
   void *reallocate(void *ptr, std::size_t oldSize,
@@ -27,6 +46,9 @@ struct SystemAllocator : IAllocator {
     deallocate(ptr, oldSize);
     return newPtr;
   }
+
+private:
+  static constexpr std::size_t kBaseAlignment = alignof(std::max_align_t);
 };
 
 } // namespace dakt::core
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../types/Result.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+#include "Thread.hpp"
+
+namespace dakt::core {
+
+// One hardware thread. Apart from `id`, every field is a dense index
+// (0, 1, ...) numbered in order of first appearance in cpus(); two CPUs with
+// equal `l2` share an L2 cache, and so on.
+struct LogicalCpu {
+  std::uint32_t id{0}; // OS CPU number, as taken by setCurrentThreadAffinity
+  std::uint32_t core{0}; // index into CpuTopology::cores()
+  std::uint32_t package{0};
+  std::uint32_t numaNode{0};
+  std::uint32_t l2{0};
+  std::uint32_t l3{0};
+};
+
+// A physical core and its SMT siblings, which are cpus()[firstCpu] up to
+// cpus()[firstCpu + cpuCount].
+struct PhysicalCore {
+  std::uint32_t firstCpu{0};
+  std::uint32_t cpuCount{0};
+  std::uint32_t package{0};
+  std::uint32_t numaNode{0};
+  std::uint32_t l2{0};
+  std::uint32_t l3{0};
+};
+
+// Snapshot of the machine's CPUs: SMT siblings, cache sharing and NUMA
+// nodes. CPUs are ordered by NUMA node, then L3 group, then core, so
+// neighbours in cpus() and cores() are also neighbours in the cache
+// hierarchy and a prefix of cores() is a compact placement.
+//
+// Linux reads sysfs: topology/core_cpus_list (or thread_siblings_list),
+// physical_package_id, cache/index*/shared_cpu_list and node*/cpulist. What
+// is missing is assumed private to the core (L2), shared per package (L3)
+// or a single node (NUMA). Other platforms get flat(): every hardware
+// thread its own core, all sharing one L3 and one node.
+class CpuTopology {
+public:
+  CpuTopology() = default;
+
+  // The calling thread's view of the machine: cpuTopology() restricted to
+  // the CPUs its affinity mask allows right now.
+  [[nodiscard]] static CpuTopology detect();
+
+  // Reads the sysfs tree under `root`, normally "/sys/devices/system",
+  // without applying any affinity mask.
+  [[nodiscard]] static Result<CpuTopology, PlatformError>
+  fromSysfs(StringView root);
+
+  [[nodiscard]] static CpuTopology flat(std::uint32_t cpuCount);
+
+  // Keeps only the CPUs whose OS numbers appear in `ids`.
+  [[nodiscard]] CpuTopology restrictedTo(Span<const std::uint32_t> ids) const;
+
+  [[nodiscard]] Span<const LogicalCpu> cpus() const noexcept {
+    return Span<const LogicalCpu>(cpus_.data(), cpus_.size());
+  }
+  [[nodiscard]] Span<const PhysicalCore> cores() const noexcept {
+    return Span<const PhysicalCore>(cores_.data(), cores_.size());
+  }
+  [[nodiscard]] Span<const LogicalCpu>
+  siblings(std::uint32_t core) const noexcept {
+    const PhysicalCore &c = cores_[core];
+    return Span<const LogicalCpu>(cpus_.data() + c.firstCpu, c.cpuCount);
+  }
+
+  [[nodiscard]] std::uint32_t packageCount() const noexcept {
+    return packageCount_;
+  }
+  [[nodiscard]] std::uint32_t numaNodeCount() const noexcept {
+    return numaNodeCount_;
+  }
+  [[nodiscard]] std::uint32_t l2Count() const noexcept { return l2Count_; }
+  [[nodiscard]] std::uint32_t l3Count() const noexcept { return l3Count_; }
+
+private:
+  // Identity of each CPU's groups before numbering: the lowest OS number
+  // among the CPUs sharing it, tagged by kind where sysfs had no answer.
+  struct RawCpu {
+    std::uint32_t id;
+    std::uint64_t core;
+    std::uint64_t package;
+    std::uint64_t numaNode;
+    std::uint64_t l2;
+    std::uint64_t l3;
+  };
+
+  static CpuTopology build(std::vector<RawCpu> raw);
+
+  std::vector<LogicalCpu> cpus_;
+  std::vector<PhysicalCore> cores_;
+  std::vector<RawCpu> raw_;
+  std::uint32_t packageCount_{0};
+  std::uint32_t numaNodeCount_{0};
+  std::uint32_t l2Count_{0};
+  std::uint32_t l3Count_{0};
+};
+
+// Every online CPU of the machine, read once on first use regardless of the
+// caller's affinity mask. Falls back to flat() when sysfs cannot be read.
+const CpuTopology &cpuTopology();
+
+} // namespace dakt::core
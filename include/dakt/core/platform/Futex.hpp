@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "Simd.hpp"
+
+// Address-based waiting on a 32-bit atomic. On Linux this is the futex system
+// call (process-private); elsewhere waiters sleep on condition variables
+// hashed by address. Either way a wake uses the address only as a key and
+// never reads the word, so it may race with the word's destruction: the
+// last decrement of a counter can wake a waiter that frees it right away.
+namespace dakt::core {
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+              std::atomic<std::uint32_t>::is_always_lock_free);
+
+// Blocks while `word` holds `expected`. May return spuriously, so callers
+// re-check their condition in a loop.
+void futexWait(const std::atomic<std::uint32_t> &word,
+               std::uint32_t expected) noexcept;
+
+// As futexWait, giving up after `timeoutNs` nanoseconds. Returns false on
+// timeout.
+bool futexWaitFor(const std::atomic<std::uint32_t> &word,
+                  std::uint32_t expected, std::uint64_t timeoutNs) noexcept;
+
+void futexWakeOne(const std::atomic<std::uint32_t> &word) noexcept;
+void futexWakeAll(const std::atomic<std::uint32_t> &word) noexcept;
+
+// Spin-wait hint: PAUSE on x86, YIELD on ARM.
+inline void cpuRelax() noexcept {
+#if DAKT_SIMD_X86
+  _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+} // namespace dakt::core
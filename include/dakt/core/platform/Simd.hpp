@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#define DAKT_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#else
+#define DAKT_SIMD_X86 0
+#endif
+
+// Per-function ISA enablement so kernels can be compiled for AVX2 without
+// raising the baseline of the whole translation unit. MSVC exposes every
+// intrinsic unconditionally and needs no attribute.
+#if DAKT_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+#define DAKT_TARGET_SSE2 __attribute__((target("sse2")))
+#define DAKT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define DAKT_TARGET_SSE2
+#define DAKT_TARGET_AVX2
+#endif
+
+namespace dakt::core {
+
+// Padding unit for data written by different threads. 64 bytes on current
+// x86 and most ARM cores; std::hardware_destructive_interference_size is not
+// used because its value may differ between translation units.
+inline constexpr std::size_t kCacheLineSize = 64;
+
+enum class SimdLevel : std::uint8_t { Scalar, SSE2, AVX2 };
+
+namespace detail {
+
+inline SimdLevel detectSimdLevel() noexcept {
+#if DAKT_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::SSE2;
+  }
+  return SimdLevel::Scalar;
+#elif DAKT_SIMD_X86 && defined(_MSC_VER)
+  int regs[4]{};
+  __cpuid(regs, 0);
+  const int maxLeaf = regs[0];
+  __cpuid(regs, 1);
+  const bool sse2 = (regs[3] & (1 << 26)) != 0;
+  const bool osxsave = (regs[2] & (1 << 27)) != 0;
+  const bool avx = (regs[2] & (1 << 28)) != 0;
+  if (maxLeaf >= 7 && osxsave && avx &&
+      (_xgetbv(0) & 0x6) == 0x6) {
+    __cpuidex(regs, 7, 0);
+    if ((regs[1] & (1 << 5)) != 0) {
+      return SimdLevel::AVX2;
+    }
+  }
+  return sse2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+} // namespace detail
+
+// Highest instruction set usable on this machine, detected once.
+[[nodiscard]] inline SimdLevel simdLevel() noexcept {
+  static const SimdLevel level = detail::detectSimdLevel();
+  return level;
+}
+
+} // namespace dakt::core
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../types/ErrorCode.hpp"
+#include "../types/Result.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+// Per-thread OS controls: CPU affinity and thread names. Implemented for
+// Linux; elsewhere the setters report Unsupported.
+namespace dakt::core {
+
+enum class PlatformError : std::uint8_t {
+  Unsupported,     // not available on this platform
+  InvalidArgument, // e.g. an empty CPU set or a CPU number out of range
+  SystemError      // the OS call failed
+};
+
+[[nodiscard]] constexpr ErrorCode toErrorCode(PlatformError e) noexcept {
+  return ErrorCode(ErrorCategory::Platform, e);
+}
+
+// Restricts the calling thread to the given OS CPU numbers.
+Result<void, PlatformError>
+setCurrentThreadAffinity(Span<const std::uint32_t> cpus) noexcept;
+
+inline Result<void, PlatformError>
+setCurrentThreadAffinity(std::uint32_t cpu) noexcept {
+  return setCurrentThreadAffinity(Span<const std::uint32_t>(&cpu, 1));
+}
+
+// OS numbers of the CPUs the calling thread may run on.
+Result<std::vector<std::uint32_t>, PlatformError> currentThreadAffinity();
+
+// Names the calling thread for debuggers and profilers. Linux keeps at most
+// 15 bytes; longer names are truncated.
+Result<void, PlatformError> setCurrentThreadName(StringView name) noexcept;
+
+// OS number of the CPU the calling thread runs on right now, or 0 if
+// unknown. Only a hint: the thread may migrate right after.
+[[nodiscard]] std::uint32_t currentCpu() noexcept;
+
+} // namespace dakt::core
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../types/Rect.hpp"
+#include "../types/Span.hpp"
+
+namespace dakt::core {
+
+// Cost model for merging dirty rects. Emitting a rect costs `perRectCost`
+// pixel-equivalents of fixed overhead (dispatch, OCR setup, export header),
+// every covered pixel costs one. Two rects are merged whenever their bounding
+// union wastes no more pixels than the overhead saved by dropping one rect.
+struct DirtyMergePolicy {
+  std::int64_t perRectCost{1024};
+  // Upper bound on the number of rects emitted per frame. Beyond it the
+  // cheapest pairs are merged regardless of waste.
+  std::size_t maxRects{32};
+};
+
+// Collects changed rects for a frame and reduces them to a small covering set.
+// Storage is reserved once at construction; steady-state use never allocates.
+class DirtyRegionTracker {
+public:
+  DirtyRegionTracker(IAllocator &allocator, std::size_t capacity,
+                     DirtyMergePolicy policy = {})
+      : allocator_(&allocator), policy_(policy),
+        capacity_(capacity < 2 ? 2 : capacity) {
+    rects_ = static_cast<Rect *>(
+        allocator_->allocate(capacity_ * sizeof(Rect), alignof(Rect)));
+  }
+
+  DirtyRegionTracker(const DirtyRegionTracker &) = delete;
+  DirtyRegionTracker &operator=(const DirtyRegionTracker &) = delete;
+
+  ~DirtyRegionTracker() {
+    allocator_->deallocate(rects_, capacity_ * sizeof(Rect));
+  }
+
+  // Restricts all future rects to `bounds` (typically the frame size).
+  void setBounds(const Rect &bounds) noexcept {
+    bounds_ = bounds;
+    hasBounds_ = true;
+  }
+
+  void setPolicy(const DirtyMergePolicy &policy) noexcept { policy_ = policy; }
+  [[nodiscard]] const DirtyMergePolicy &policy() const noexcept {
+    return policy_;
+  }
+
+  void markDirty(Rect r) noexcept {
+    if (hasBounds_) {
+      r = intersect(r, bounds_);
+    }
+    if (r.empty()) {
+      return;
+    }
+    for (std::size_t i = 0; i < count_; ++i) {
+      if (intersect(rects_[i], r) == r) {
+        return;
+      }
+    }
+    if (count_ == capacity_) {
+      mergeBeneficial();
+    }
+    if (count_ == capacity_) {
+      // Still full: fold the new rect into whichever existing one it widens
+      // least.
+      std::size_t best = 0;
+      std::int64_t bestWaste = std::numeric_limits<std::int64_t>::max();
+      for (std::size_t i = 0; i < count_; ++i) {
+        const std::int64_t w = waste(rects_[i], r);
+        if (w < bestWaste) {
+          bestWaste = w;
+          best = i;
+        }
+      }
+      rects_[best] = unite(rects_[best], r);
+      return;
+    }
+    rects_[count_++] = r;
+  }
+
+  // Merges the collected rects according to the policy and returns the
+  // covering set. The view stays valid until the next markDirty() or reset().
+  [[nodiscard]] Span<const Rect> resolve() noexcept {
+    mergeBeneficial();
+    while (count_ > policy_.maxRects && count_ > 1) {
+      std::size_t bi = 0;
+      std::size_t bj = 1;
+      std::int64_t bestWaste = std::numeric_limits<std::int64_t>::max();
+      for (std::size_t i = 0; i < count_; ++i) {
+        for (std::size_t j = i + 1; j < count_; ++j) {
+          const std::int64_t w = waste(rects_[i], rects_[j]);
+          if (w < bestWaste) {
+            bestWaste = w;
+            bi = i;
+            bj = j;
+          }
+        }
+      }
+      mergeInto(bi, bj);
+      mergeBeneficial();
+    }
+    return Span<const Rect>(rects_, count_);
+  }
+
+  // Sum of the areas of the current rects (an upper bound on dirty pixels).
+  [[nodiscard]] std::int64_t coveredArea() const noexcept {
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < count_; ++i) {
+      total += rects_[i].area();
+    }
+    return total;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return count_; }
+  [[nodiscard]] bool empty() const noexcept { return count_ == 0; }
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+  void reset() noexcept { count_ = 0; }
+
+private:
+  // Pixels covered by unite(a, b) that neither a nor b covers.
+  [[nodiscard]] static std::int64_t waste(const Rect &a,
+                                          const Rect &b) noexcept {
+    return unite(a, b).area() - a.area() - b.area() + intersect(a, b).area();
+  }
+
+  void mergeInto(std::size_t i, std::size_t j) noexcept {
+    rects_[i] = unite(rects_[i], rects_[j]);
+    rects_[j] = rects_[--count_];
+  }
+
+  void mergeBeneficial() noexcept {
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (std::size_t i = 0; i < count_; ++i) {
+        for (std::size_t j = i + 1; j < count_;) {
+          if (waste(rects_[i], rects_[j]) <= policy_.perRectCost) {
+            mergeInto(i, j);
+            merged = true;
+            // rects_[i] grew; re-test it against everything after it.
+            j = i + 1;
+          } else {
+            ++j;
+          }
+        }
+      }
+    }
+  }
+
+  IAllocator *allocator_;
+  DirtyMergePolicy policy_;
+  Rect *rects_{nullptr};
+  std::size_t capacity_;
+  std::size_t count_{0};
+  Rect bounds_{};
+  bool hasBounds_{false};
+};
+
+} // namespace dakt::core
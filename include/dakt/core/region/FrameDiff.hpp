@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "../platform/Simd.hpp"
+#include "../types/ImageView.hpp"
+#include "../types/Rect.hpp"
+#include "../types/Span.hpp"
+#include "DirtyRegionTracker.hpp"
+
+namespace dakt::core {
+
+// Pixel types the SAD kernels may treat as plain bytes. One-byte types
+// (std::uint8_t, std::byte, ...) qualify as they are; specialize this as true
+// for packed formats whose channels are all bytes, such as a BGRA struct.
+template <typename T>
+inline constexpr bool kByteChannelPixel =
+    sizeof(T) == 1 && std::is_trivially_copyable_v<T>;
+
+template <typename T>
+concept BytePixel = kByteChannelPixel<std::remove_cv_t<T>>;
+
+namespace detail::framediff {
+
+using SadRowFn = std::uint64_t (*)(const std::uint8_t *, const std::uint8_t *,
+                                   std::size_t) noexcept;
+
+inline std::uint64_t sadRowScalar(const std::uint8_t *a,
+                                  const std::uint8_t *b,
+                                  std::size_t n) noexcept {
+  std::uint64_t sum = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    sum += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+  }
+  return sum;
+}
+
+#if DAKT_SIMD_X86
+
+DAKT_TARGET_SSE2 inline std::uint64_t sadRowSse2(const std::uint8_t *a,
+                                                 const std::uint8_t *b,
+                                                 std::size_t n) noexcept {
+  __m128i acc = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i va =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+    const __m128i vb =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+    acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+  }
+  alignas(16) std::uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+  return lanes[0] + lanes[1] + sadRowScalar(a + i, b + i, n - i);
+}
+
+DAKT_TARGET_AVX2 inline std::uint64_t sadRowAvx2(const std::uint8_t *a,
+                                                 const std::uint8_t *b,
+                                                 std::size_t n) noexcept {
+  __m256i acc = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i va =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+    const __m256i vb =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+    acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+  }
+  alignas(32) std::uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+  return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         sadRowScalar(a + i, b + i, n - i);
+}
+
+#endif // DAKT_SIMD_X86
+
+[[nodiscard]] inline SadRowFn selectSadRow() noexcept {
+#if DAKT_SIMD_X86
+  switch (simdLevel()) {
+  case SimdLevel::AVX2:
+    return &sadRowAvx2;
+  case SimdLevel::SSE2:
+    return &sadRowSse2;
+  case SimdLevel::Scalar:
+    break;
+  }
+#endif
+  return &sadRowScalar;
+}
+
+template <BytePixel T>
+[[nodiscard]] ImageView<const std::uint8_t> asBytes(ImageView<T> v) noexcept {
+  return ImageView<const std::uint8_t>(
+      reinterpret_cast<const std::uint8_t *>(v.data()),
+      v.width() * sizeof(std::remove_const_t<T>), v.height(), v.strideBytes());
+}
+
+// SAD over the overlap of two byte views (their common top-left extent),
+// abandoning the scan once the running sum exceeds `stopAbove`.
+inline std::uint64_t sadBytes(SadRowFn rowFn, ImageView<const std::uint8_t> a,
+                              ImageView<const std::uint8_t> b,
+                              std::uint64_t stopAbove) noexcept {
+  const std::size_t width = std::min(a.width(), b.width());
+  const std::size_t height = std::min(a.height(), b.height());
+  std::uint64_t sum = 0;
+  for (std::size_t y = 0; y < height; ++y) {
+    sum += rowFn(a.rowPtr(y), b.rowPtr(y), width);
+    if (sum > stopAbove) {
+      break;
+    }
+  }
+  return sum;
+}
+
+} // namespace detail::framediff
+
+// Fixed tiling of a width x height frame; edge tiles are truncated.
+struct TileGrid {
+  std::size_t tileWidth{0};
+  std::size_t tileHeight{0};
+  std::size_t columns{0};
+  std::size_t rows{0};
+
+  [[nodiscard]] static constexpr TileGrid
+  make(std::size_t width, std::size_t height, std::size_t tileWidth,
+       std::size_t tileHeight) noexcept {
+    if (tileWidth == 0 || tileHeight == 0) {
+      return TileGrid{};
+    }
+    return TileGrid{tileWidth, tileHeight,
+                    (width + tileWidth - 1) / tileWidth,
+                    (height + tileHeight - 1) / tileHeight};
+  }
+
+  [[nodiscard]] constexpr std::size_t count() const noexcept {
+    return columns * rows;
+  }
+
+  // Unclipped rect of tile `index` (row-major).
+  [[nodiscard]] constexpr Rect tileRect(std::size_t index) const noexcept {
+    return Rect{static_cast<int>((index % columns) * tileWidth),
+                static_cast<int>((index / columns) * tileHeight),
+                static_cast<int>(tileWidth), static_cast<int>(tileHeight)};
+  }
+};
+
+// Sum of absolute byte differences between two views of equal size; views of
+// different sizes are compared over their overlap. With a finite `stopAbove`
+// the scan ends as soon as the sum passes it, so the result is only exact
+// when it is <= stopAbove.
+template <BytePixel T>
+[[nodiscard]] std::uint64_t
+sumAbsDiff(ImageView<T> prev, ImageView<T> cur,
+           std::uint64_t stopAbove =
+               std::numeric_limits<std::uint64_t>::max()) noexcept {
+  return detail::framediff::sadBytes(detail::framediff::selectSadRow(),
+                                     detail::framediff::asBytes(prev),
+                                     detail::framediff::asBytes(cur),
+                                     stopAbove);
+}
+
+// True when the SAD inside `region` exceeds `threshold`. The region is
+// clipped to the part both frames cover, e.g. across a capture resize.
+template <BytePixel T>
+[[nodiscard]] bool regionChanged(ImageView<T> prev, ImageView<T> cur,
+                                 const Rect &region,
+                                 std::uint64_t threshold) noexcept {
+  const Rect common{0, 0,
+                    static_cast<int>(std::min(prev.width(), cur.width())),
+                    static_cast<int>(std::min(prev.height(), cur.height()))};
+  const Rect clipped = intersect(region, common);
+  return sumAbsDiff(prev.subview(clipped), cur.subview(clipped), threshold) >
+         threshold;
+}
+
+// Compares every tile of `grid` and sets bit i of `changed` for tiles whose
+// SAD exceeds `threshold`. When `scores` is non-empty it receives each tile's
+// SAD (a lower bound once it passed the threshold). Returns the number of
+// changed tiles. Frames of different sizes are compared over their overlap.
+template <BytePixel T>
+std::size_t diffTiles(ImageView<T> prev, ImageView<T> cur,
+                      const TileGrid &grid, std::uint64_t threshold,
+                      Span<std::uint64_t> changed,
+                      Span<std::uint64_t> scores = {}) noexcept {
+  const auto rowFn = detail::framediff::selectSadRow();
+  const std::size_t tiles = std::min(grid.count(), changed.size() * 64);
+  for (std::size_t k = 0; k < (tiles + 63) / 64; ++k) {
+    changed[k] = 0;
+  }
+  std::size_t count = 0;
+  for (std::size_t i = 0; i < tiles; ++i) {
+    const Rect r = grid.tileRect(i);
+    const std::uint64_t sad = detail::framediff::sadBytes(
+        rowFn, detail::framediff::asBytes(prev.subview(r)),
+        detail::framediff::asBytes(cur.subview(r)), threshold);
+    if (i < scores.size()) {
+      scores[i] = sad;
+    }
+    if (sad > threshold) {
+      changed[i / 64] |= std::uint64_t{1} << (i % 64);
+      ++count;
+    }
+  }
+  return count;
+}
+
+// Feeds the tiles flagged by diffTiles() into a dirty-region tracker.
+inline void markChangedTiles(const TileGrid &grid,
+                             Span<const std::uint64_t> changed,
+                             DirtyRegionTracker &tracker) noexcept {
+  const std::size_t tiles = std::min(grid.count(), changed.size() * 64);
+  for (std::size_t k = 0; k * 64 < tiles; ++k) {
+    for (std::uint64_t bits = changed[k]; bits != 0; bits &= bits - 1) {
+      const std::size_t i = k * 64 + std::countr_zero(bits);
+      if (i < tiles) {
+        tracker.markDirty(grid.tileRect(i));
+      }
+    }
+  }
+}
+
+} // namespace dakt::core
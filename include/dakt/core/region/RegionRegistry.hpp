@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../interfaces/IRegionProvider.hpp"
+#include "../types/Rect.hpp"
+#include "../types/Result.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+namespace dakt::core {
+
+struct RegionEntry {
+  std::string name;
+  Rect rect{};
+};
+
+// Parses a region layout: one `name = x, y, width, height` per line, `#`
+// starts a comment, blank lines are ignored. Later duplicates win.
+Result<std::vector<RegionEntry>, std::string>
+parseRegionLayout(StringView text);
+
+// IRegionProvider whose contents can be replaced while other threads query it.
+// Each publish builds an immutable snapshot and swaps it in with one atomic
+// store; readers pin the current epoch with a counter and never wait on a
+// lock. Writers are serialized and wait for readers of the previous epoch to
+// leave before freeing the old snapshot.
+//
+// Region names are kept in a registry-lifetime pool, so the StringViews
+// returned by listRegions() stay valid across reloads.
+class RegionRegistry final : public IRegionProvider {
+public:
+  RegionRegistry();
+  ~RegionRegistry() override;
+
+  RegionRegistry(const RegionRegistry &) = delete;
+  RegionRegistry &operator=(const RegionRegistry &) = delete;
+
+  Result<Rect, std::string> getRegion(StringView name) const override {
+    const ReadGuard guard(*this);
+    const Snapshot *snap = guard.snapshot();
+    const auto it = std::lower_bound(
+        snap->slots.begin(), snap->slots.end(), name,
+        [](const Slot &slot, StringView key) { return slot.name < key; });
+    if (it == snap->slots.end() || it->name != name) {
+      return Result<Rect, std::string>::err("unknown region: " +
+                                            name.toString());
+    }
+    return Result<Rect, std::string>::ok(it->rect);
+  }
+
+  std::vector<StringView> listRegions() const override {
+    const ReadGuard guard(*this);
+    const Snapshot *snap = guard.snapshot();
+    std::vector<StringView> names;
+    names.reserve(snap->slots.size());
+    for (const Slot &slot : snap->slots) {
+      names.push_back(slot.name);
+    }
+    return names;
+  }
+
+  // Replaces the whole layout.
+  void publish(Span<const RegionEntry> entries);
+
+  // Parses `path` and publishes it. On failure the current layout is kept.
+  Result<void, std::string> loadFile(const std::string &path);
+
+  // Loads `path` and then reloads it in a background thread whenever it
+  // changes (inotify on Linux, modification-time polling elsewhere). Replaces
+  // any previous watch. A reload that finds no regions counts as a failure
+  // and keeps the current layout, since it usually means the file was caught
+  // mid-write.
+  Result<void, std::string> watchFile(const std::string &path);
+  void stopWatching();
+
+  // Number of layouts published so far.
+  [[nodiscard]] std::uint64_t generation() const noexcept {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  // Number of background reloads that failed to read or parse the file, or
+  // found it empty.
+  [[nodiscard]] std::uint64_t reloadFailures() const noexcept {
+    return reloadFailures_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Slot {
+    StringView name;
+    Rect rect;
+  };
+
+  struct Snapshot {
+    std::vector<Slot> slots;
+  };
+
+  struct alignas(64) ReaderCount {
+    std::atomic<std::uint64_t> value{0};
+  };
+
+  class ReadGuard {
+  public:
+    explicit ReadGuard(const RegionRegistry &owner) noexcept : owner_(owner) {
+      for (;;) {
+        epoch_ = owner_.epoch_.load(std::memory_order_seq_cst);
+        owner_.readers_[epoch_ & 1].value.fetch_add(1,
+                                                    std::memory_order_seq_cst);
+        if (owner_.epoch_.load(std::memory_order_seq_cst) == epoch_) {
+          break;
+        }
+        owner_.readers_[epoch_ & 1].value.fetch_sub(1,
+                                                    std::memory_order_release);
+      }
+      snapshot_ = owner_.current_.load(std::memory_order_acquire);
+    }
+
+    ~ReadGuard() {
+      owner_.readers_[epoch_ & 1].value.fetch_sub(1, std::memory_order_release);
+    }
+
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+
+    [[nodiscard]] const Snapshot *snapshot() const noexcept {
+      return snapshot_;
+    }
+
+  private:
+    const RegionRegistry &owner_;
+    std::uint64_t epoch_{0};
+    const Snapshot *snapshot_{nullptr};
+  };
+
+  struct Watcher;
+
+  Result<void, std::string> load(const std::string &path, bool allowEmpty);
+  void swapIn(Snapshot *next);
+  StringView internName(const std::string &name);
+
+  std::atomic<const Snapshot *> current_;
+  std::atomic<std::uint64_t> epoch_{0};
+  mutable ReaderCount readers_[2];
+  std::atomic<std::uint64_t> generation_{0};
+  std::atomic<std::uint64_t> reloadFailures_{0};
+
+  std::mutex writeMutex_;
+  std::set<std::string, std::less<>> namePool_;
+  std::unique_ptr<Watcher> watcher_;
+};
+
+} // namespace dakt::core
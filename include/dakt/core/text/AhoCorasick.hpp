@@ -0,0 +1,255 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+namespace dakt::core {
+
+struct TextMatch {
+  std::size_t pattern{0};
+  std::size_t offset{0};
+  std::size_t length{0};
+};
+
+namespace detail::ac {
+
+inline constexpr std::uint32_t kNoPattern = 0xFFFFFFFFu;
+
+// Fully resolved automaton: `next` is a dense states x classes DFA table with
+// failure transitions already folded in, so scanning is one table load per
+// input byte. Bytes that occur in no pattern share class 0.
+struct Tables {
+  std::array<std::uint16_t, 256> classOf{};
+  std::uint32_t classes{1};
+  std::uint32_t states{1};
+  std::vector<std::uint32_t> next;
+  // Pattern ending exactly at a state, or kNoPattern.
+  std::vector<std::uint32_t> pattern;
+  // First state at or below this one (via suffix links) that ends a pattern;
+  // 0 when none does.
+  std::vector<std::uint32_t> output;
+  // Next pattern-ending state along the suffix chain.
+  std::vector<std::uint32_t> dictLink;
+  std::vector<std::uint32_t> lengths;
+};
+
+constexpr Tables build(Span<const StringView> patterns) {
+  Tables t;
+  for (const StringView p : patterns) {
+    for (std::size_t i = 0; i < p.size(); ++i) {
+      auto &cls = t.classOf[static_cast<unsigned char>(p[i])];
+      if (cls == 0) {
+        cls = static_cast<std::uint16_t>(t.classes++);
+      }
+    }
+  }
+  const std::uint32_t classes = t.classes;
+
+  t.next.assign(classes, 0);
+  t.pattern.assign(1, kNoPattern);
+  t.lengths.reserve(patterns.size());
+  for (std::size_t id = 0; id < patterns.size(); ++id) {
+    const StringView p = patterns[id];
+    t.lengths.push_back(static_cast<std::uint32_t>(p.size()));
+    if (p.empty()) {
+      continue;
+    }
+    std::uint32_t s = 0;
+    for (std::size_t i = 0; i < p.size(); ++i) {
+      const std::uint32_t c = t.classOf[static_cast<unsigned char>(p[i])];
+      if (t.next[s * classes + c] == 0) {
+        t.next[s * classes + c] = t.states++;
+        t.next.resize(static_cast<std::size_t>(t.states) * classes, 0);
+        t.pattern.push_back(kNoPattern);
+      }
+      s = t.next[s * classes + c];
+    }
+    if (t.pattern[s] == kNoPattern) {
+      t.pattern[s] = static_cast<std::uint32_t>(id);
+    }
+  }
+
+  // Breadth-first pass: trie edges become failure-resolved DFA edges.
+  std::vector<std::uint32_t> fail(t.states, 0);
+  t.output.assign(t.states, 0);
+  t.dictLink.assign(t.states, 0);
+  std::vector<std::uint32_t> queue;
+  queue.reserve(t.states);
+  for (std::uint32_t c = 0; c < classes; ++c) {
+    if (const std::uint32_t child = t.next[c]; child != 0) {
+      queue.push_back(child);
+    }
+  }
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const std::uint32_t s = queue[head];
+    const std::uint32_t f = fail[s];
+    t.dictLink[s] = t.pattern[f] != kNoPattern ? f : t.dictLink[f];
+    t.output[s] = t.pattern[s] != kNoPattern ? s : t.dictLink[s];
+    for (std::uint32_t c = 0; c < classes; ++c) {
+      std::uint32_t &edge = t.next[s * classes + c];
+      const std::uint32_t viaFail = t.next[f * classes + c];
+      if (edge != 0) {
+        fail[edge] = viaFail;
+        queue.push_back(edge);
+      } else {
+        edge = viaFail;
+      }
+    }
+  }
+  return t;
+}
+
+// Non-owning view shared by the run-time and compile-time automata.
+struct View {
+  const std::uint16_t *classOf;
+  std::uint32_t classes;
+  const std::uint32_t *next;
+  const std::uint32_t *pattern;
+  const std::uint32_t *output;
+  const std::uint32_t *dictLink;
+  const std::uint32_t *lengths;
+
+  // Reports every match (including overlapping ones) in end-position order.
+  // A callback returning bool can stop the scan by returning false; the
+  // function then returns false as well.
+  template <typename F> constexpr bool scan(StringView text, F &&f) const {
+    std::uint32_t s = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+      s = next[s * classes + classOf[static_cast<unsigned char>(text[i])]];
+      for (std::uint32_t o = output[s]; o != 0; o = dictLink[o]) {
+        const std::uint32_t id = pattern[o];
+        const TextMatch m{id, i + 1 - lengths[id], lengths[id]};
+        if constexpr (std::is_same_v<
+                          std::invoke_result_t<F &, const TextMatch &>, bool>) {
+          if (!std::invoke(f, m)) {
+            return false;
+          }
+        } else {
+          std::invoke(f, m);
+        }
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace detail::ac
+
+// Multi-pattern matcher built once from a pattern set and then scanned in one
+// pass per text. Duplicate patterns report the lowest index; empty patterns
+// never match.
+class AhoCorasick {
+public:
+  AhoCorasick() : AhoCorasick(Span<const StringView>{}) {}
+  explicit AhoCorasick(Span<const StringView> patterns)
+      : tables_(detail::ac::build(patterns)) {}
+
+  [[nodiscard]] std::size_t patternCount() const noexcept {
+    return tables_.lengths.size();
+  }
+  [[nodiscard]] std::size_t stateCount() const noexcept {
+    return tables_.states;
+  }
+
+  template <typename F> bool scan(StringView text, F &&f) const {
+    return view().scan(text, std::forward<F>(f));
+  }
+
+  [[nodiscard]] bool containsAny(StringView text) const {
+    return !view().scan(text, [](const TextMatch &) { return false; });
+  }
+
+  [[nodiscard]] std::size_t countMatches(StringView text) const {
+    std::size_t n = 0;
+    view().scan(text, [&n](const TextMatch &) { ++n; });
+    return n;
+  }
+
+private:
+  [[nodiscard]] detail::ac::View view() const noexcept {
+    return {tables_.classOf.data(), tables_.classes,
+            tables_.next.data(),    tables_.pattern.data(),
+            tables_.output.data(),  tables_.dictLink.data(),
+            tables_.lengths.data()};
+  }
+
+  detail::ac::Tables tables_;
+};
+
+// Same automaton with all tables in fixed-size arrays, constructible in a
+// constant expression. Use makeStaticAhoCorasick<Patterns>() to size it.
+template <std::size_t States, std::size_t Classes, std::size_t Patterns>
+class StaticAhoCorasick {
+public:
+  constexpr explicit StaticAhoCorasick(Span<const StringView> patterns) {
+    const detail::ac::Tables t = detail::ac::build(patterns);
+    classOf_ = t.classOf;
+    for (std::size_t i = 0; i < States * Classes; ++i) {
+      next_[i] = t.next[i];
+    }
+    for (std::size_t i = 0; i < States; ++i) {
+      pattern_[i] = t.pattern[i];
+      output_[i] = t.output[i];
+      dictLink_[i] = t.dictLink[i];
+    }
+    for (std::size_t i = 0; i < Patterns; ++i) {
+      lengths_[i] = t.lengths[i];
+    }
+  }
+
+  [[nodiscard]] static constexpr std::size_t patternCount() noexcept {
+    return Patterns;
+  }
+  [[nodiscard]] static constexpr std::size_t stateCount() noexcept {
+    return States;
+  }
+
+  template <typename F> constexpr bool scan(StringView text, F &&f) const {
+    return view().scan(text, std::forward<F>(f));
+  }
+
+  [[nodiscard]] constexpr bool containsAny(StringView text) const {
+    return !view().scan(text, [](const TextMatch &) { return false; });
+  }
+
+  [[nodiscard]] constexpr std::size_t countMatches(StringView text) const {
+    std::size_t n = 0;
+    view().scan(text, [&n](const TextMatch &) { ++n; });
+    return n;
+  }
+
+private:
+  [[nodiscard]] constexpr detail::ac::View view() const noexcept {
+    return {classOf_.data(),  static_cast<std::uint32_t>(Classes),
+            next_.data(),     pattern_.data(),
+            output_.data(),   dictLink_.data(),
+            lengths_.data()};
+  }
+
+  std::array<std::uint16_t, 256> classOf_{};
+  std::array<std::uint32_t, States * Classes> next_{};
+  std::array<std::uint32_t, States> pattern_{};
+  std::array<std::uint32_t, States> output_{};
+  std::array<std::uint32_t, States> dictLink_{};
+  std::array<std::uint32_t, Patterns> lengths_{};
+};
+
+// Builds a StaticAhoCorasick from a constexpr array of StringViews, e.g.
+//   static constexpr StringView kWords[] = {StringView("he"), ...};
+//   constexpr auto matcher = makeStaticAhoCorasick<kWords>();
+template <const auto &Patterns> consteval auto makeStaticAhoCorasick() {
+  constexpr Span<const StringView> span(Patterns);
+  constexpr std::size_t states = detail::ac::build(span).states;
+  constexpr std::size_t classes = detail::ac::build(span).classes;
+  return StaticAhoCorasick<states, classes, span.size()>(span);
+}
+
+} // namespace dakt::core
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "../hash/Hash.hpp"
+#include "../platform/Simd.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+// ASCII case folding. Only 'A'-'Z' and 'a'-'z' are folded; every other byte,
+// including each byte of a multi-byte UTF-8 sequence, must match exactly, so
+// the functions are safe on UTF-8 input and never split a sequence.
+namespace dakt::core {
+
+namespace detail::asciicase {
+
+enum class Fold : std::uint8_t { Lower, Upper };
+
+[[nodiscard]] constexpr char lower(char c) noexcept {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c | 0x20) : c;
+}
+
+[[nodiscard]] constexpr char upper(char c) noexcept {
+  return c >= 'a' && c <= 'z' ? static_cast<char>(c & ~0x20) : c;
+}
+
+constexpr void convertScalar(const char *src, char *dst, std::size_t n,
+                             Fold fold) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = fold == Fold::Lower ? lower(src[i]) : upper(src[i]);
+  }
+}
+
+[[nodiscard]] constexpr bool equalScalar(const char *a, const char *b,
+                                         std::size_t n) noexcept {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (lower(a[i]) != lower(b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if DAKT_SIMD_X86
+
+// Letters of the source case are found with one signed compare after biasing
+// the range start to -128, then have bit 0x20 flipped.
+DAKT_TARGET_SSE2 inline __m128i foldSse2(__m128i v, char first) noexcept {
+  const __m128i biased =
+      _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+  const __m128i letter =
+      _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(-128 + 26)));
+  return _mm_xor_si128(v, _mm_and_si128(letter, _mm_set1_epi8(0x20)));
+}
+
+DAKT_TARGET_AVX2 inline __m256i foldAvx2(__m256i v, char first) noexcept {
+  const __m256i biased = _mm256_add_epi8(
+      v, _mm256_set1_epi8(static_cast<char>(0x80 - first)));
+  const __m256i letter = _mm256_cmpgt_epi8(
+      _mm256_set1_epi8(static_cast<char>(-128 + 26)), biased);
+  return _mm256_xor_si256(v, _mm256_and_si256(letter, _mm256_set1_epi8(0x20)));
+}
+
+DAKT_TARGET_SSE2 inline std::size_t convertSse2(const char *src, char *dst,
+                                                std::size_t n,
+                                                char first) noexcept {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), foldSse2(v, first));
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t convertAvx2(const char *src, char *dst,
+                                                std::size_t n,
+                                                char first) noexcept {
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                        foldAvx2(v, first));
+  }
+  return i;
+}
+
+// Returns the number of leading bytes known equal, or n + 1 on a mismatch.
+DAKT_TARGET_SSE2 inline std::size_t equalSse2(const char *a, const char *b,
+                                              std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i va = foldSse2(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)), 'A');
+    const __m128i vb = foldSse2(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)), 'A');
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF) {
+      return n + 1;
+    }
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t equalAvx2(const char *a, const char *b,
+                                              std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i va = foldAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)), 'A');
+    const __m256i vb = foldAvx2(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)), 'A');
+    if (static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xFFFFFFFFu) {
+      return n + 1;
+    }
+  }
+  return i;
+}
+
+#endif // DAKT_SIMD_X86
+
+inline void convert(const char *src, char *dst, std::size_t n,
+                    Fold fold) noexcept {
+  std::size_t i = 0;
+#if DAKT_SIMD_X86
+  const char first = fold == Fold::Lower ? 'A' : 'a';
+  switch (simdLevel()) {
+  case SimdLevel::AVX2:
+    i = convertAvx2(src, dst, n, first);
+    break;
+  case SimdLevel::SSE2:
+    i = convertSse2(src, dst, n, first);
+    break;
+  case SimdLevel::Scalar:
+    break;
+  }
+#endif
+  convertScalar(src + i, dst + i, n - i, fold);
+}
+
+[[nodiscard]] inline bool equal(const char *a, const char *b,
+                                std::size_t n) noexcept {
+  std::size_t i = 0;
+#if DAKT_SIMD_X86
+  switch (simdLevel()) {
+  case SimdLevel::AVX2:
+    i = equalAvx2(a, b, n);
+    break;
+  case SimdLevel::SSE2:
+    i = equalSse2(a, b, n);
+    break;
+  case SimdLevel::Scalar:
+    break;
+  }
+  if (i > n) {
+    return false;
+  }
+#endif
+  return equalScalar(a + i, b + i, n - i);
+}
+
+} // namespace detail::asciicase
+
+[[nodiscard]] constexpr bool equalsIgnoreCase(StringView a,
+                                              StringView b) noexcept {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  if consteval {
+    return detail::asciicase::equalScalar(a.data(), b.data(), a.size());
+  } else {
+    return detail::asciicase::equal(a.data(), b.data(), a.size());
+  }
+}
+
+[[nodiscard]] constexpr bool startsWithIgnoreCase(StringView text,
+                                                  StringView prefix) noexcept {
+  return text.size() >= prefix.size() &&
+         equalsIgnoreCase(text.substr(0, prefix.size()), prefix);
+}
+
+[[nodiscard]] constexpr bool endsWithIgnoreCase(StringView text,
+                                                StringView suffix) noexcept {
+  return text.size() >= suffix.size() &&
+         equalsIgnoreCase(text.substr(text.size() - suffix.size()), suffix);
+}
+
+// In-place conversion.
+constexpr void toLower(Span<char> text) noexcept {
+  if consteval {
+    detail::asciicase::convertScalar(text.data(), text.data(), text.size(),
+                                     detail::asciicase::Fold::Lower);
+  } else {
+    detail::asciicase::convert(text.data(), text.data(), text.size(),
+                               detail::asciicase::Fold::Lower);
+  }
+}
+
+constexpr void toUpper(Span<char> text) noexcept {
+  if consteval {
+    detail::asciicase::convertScalar(text.data(), text.data(), text.size(),
+                                     detail::asciicase::Fold::Upper);
+  } else {
+    detail::asciicase::convert(text.data(), text.data(), text.size(),
+                               detail::asciicase::Fold::Upper);
+  }
+}
+
+// Converts into `out` and returns the number of bytes written, which is
+// shorter than `text` only when `out` is.
+constexpr std::size_t toLower(StringView text, Span<char> out) noexcept {
+  const std::size_t n = text.size() < out.size() ? text.size() : out.size();
+  if consteval {
+    detail::asciicase::convertScalar(text.data(), out.data(), n,
+                                     detail::asciicase::Fold::Lower);
+  } else {
+    detail::asciicase::convert(text.data(), out.data(), n,
+                               detail::asciicase::Fold::Lower);
+  }
+  return n;
+}
+
+constexpr std::size_t toUpper(StringView text, Span<char> out) noexcept {
+  const std::size_t n = text.size() < out.size() ? text.size() : out.size();
+  if consteval {
+    detail::asciicase::convertScalar(text.data(), out.data(), n,
+                                     detail::asciicase::Fold::Upper);
+  } else {
+    detail::asciicase::convert(text.data(), out.data(), n,
+                               detail::asciicase::Fold::Upper);
+  }
+  return n;
+}
+
+// Hash that agrees with equalsIgnoreCase. Input is lowered through a stack
+// buffer in blocks, so nothing is allocated; up to one block it equals
+// hash() of the lowered text.
+[[nodiscard]] constexpr std::uint64_t
+hashIgnoreCase(StringView text, std::uint64_t seed = 0) noexcept {
+  constexpr std::size_t kBlock = 256;
+  char buf[kBlock]{};
+  std::uint64_t h = seed;
+  std::size_t pos = 0;
+  do {
+    const StringView block = text.substr(pos, kBlock);
+    const std::size_t n = toLower(block, Span<char>(buf, kBlock));
+    h = hash(StringView(buf, n), h);
+    pos += kBlock;
+  } while (pos < text.size());
+  return h;
+}
+
+// Transparent functors for unordered containers keyed case-insensitively.
+struct StringHashIgnoreCase {
+  using is_transparent = void;
+
+  [[nodiscard]] std::size_t operator()(StringView s) const noexcept {
+    return static_cast<std::size_t>(hashIgnoreCase(s));
+  }
+  [[nodiscard]] std::size_t operator()(std::string_view s) const noexcept {
+    return static_cast<std::size_t>(
+        hashIgnoreCase(StringView(s.data(), s.size())));
+  }
+  [[nodiscard]] std::size_t operator()(const std::string &s) const noexcept {
+    return static_cast<std::size_t>(hashIgnoreCase(StringView(s)));
+  }
+};
+
+struct StringEqualIgnoreCase {
+  using is_transparent = void;
+
+  [[nodiscard]] bool operator()(StringView a, StringView b) const noexcept {
+    return equalsIgnoreCase(a, b);
+  }
+};
+
+} // namespace dakt::core
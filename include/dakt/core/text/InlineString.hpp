@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <utility>
+
+#include "../types/StringView.hpp"
+
+namespace dakt::core {
+
+// String with room for N characters stored inline; it never allocates. Writes
+// that do not fit are truncated and reported by returning false, after which
+// truncated() stays set until clear(). The contents are always
+// null-terminated.
+template <std::size_t N> class InlineString {
+public:
+  constexpr InlineString() noexcept = default;
+  constexpr explicit InlineString(StringView text) noexcept { append(text); }
+
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+  [[nodiscard]] constexpr bool truncated() const noexcept {
+    return truncated_;
+  }
+
+  [[nodiscard]] constexpr const char *data() const noexcept { return buf_; }
+  [[nodiscard]] constexpr const char *c_str() const noexcept { return buf_; }
+  [[nodiscard]] constexpr StringView view() const noexcept {
+    return StringView(buf_, size_);
+  }
+  constexpr operator StringView() const noexcept { return view(); }
+
+  [[nodiscard]] constexpr char operator[](std::size_t i) const noexcept {
+    return buf_[i];
+  }
+
+  constexpr bool append(char c) noexcept {
+    if (size_ == N) {
+      truncated_ = true;
+      return false;
+    }
+    buf_[size_++] = c;
+    buf_[size_] = '\0';
+    return true;
+  }
+
+  constexpr bool append(StringView text) noexcept {
+    const std::size_t room = N - size_;
+    const bool fits = text.size() <= room;
+    const std::size_t n = fits ? text.size() : room;
+    for (std::size_t i = 0; i < n; ++i) {
+      buf_[size_ + i] = text[i];
+    }
+    size_ += n;
+    buf_[size_] = '\0';
+    truncated_ = truncated_ || !fits;
+    return fits;
+  }
+
+  // Formats straight into the inline buffer with std::format_to_n.
+  template <typename... Args>
+  bool appendFormat(std::format_string<Args...> fmt, Args &&...args) {
+    const std::size_t room = N - size_;
+    const auto r = std::format_to_n(buf_ + size_,
+                                    static_cast<std::ptrdiff_t>(room), fmt,
+                                    std::forward<Args>(args)...);
+    const bool fits = static_cast<std::size_t>(r.size) <= room;
+    size_ += fits ? static_cast<std::size_t>(r.size) : room;
+    buf_[size_] = '\0';
+    truncated_ = truncated_ || !fits;
+    return fits;
+  }
+
+  template <typename... Args>
+  bool assignFormat(std::format_string<Args...> fmt, Args &&...args) {
+    clear();
+    return appendFormat(fmt, std::forward<Args>(args)...);
+  }
+
+  constexpr void clear() noexcept {
+    size_ = 0;
+    buf_[0] = '\0';
+    truncated_ = false;
+  }
+
+  // Shortens the contents to `n` characters; no-op when already shorter.
+  constexpr void resize(std::size_t n) noexcept {
+    if (n < size_) {
+      size_ = n;
+      buf_[size_] = '\0';
+    }
+  }
+
+  [[nodiscard]] constexpr bool
+  operator==(const InlineString &other) const noexcept {
+    return view() == other.view();
+  }
+  [[nodiscard]] constexpr bool operator==(StringView other) const noexcept {
+    return view() == other;
+  }
+
+private:
+  char buf_[N + 1]{};
+  std::size_t size_{0};
+  bool truncated_{false};
+};
+
+} // namespace dakt::core
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "../platform/Simd.hpp"
+#include "../types/ErrorCode.hpp"
+#include "../types/Result.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+#include "InlineString.hpp"
+#include "Split.hpp"
+
+namespace dakt::core {
+
+enum class NumberError : std::uint8_t {
+  Empty,         // no characters
+  Invalid,       // not a number, or characters left over after it
+  OutOfRange,    // does not fit the requested type
+  BufferTooSmall // formatting output or column span too short
+};
+
+[[nodiscard]] constexpr ErrorCode toErrorCode(NumberError e) noexcept {
+  return ErrorCode(ErrorCategory::Number, e);
+}
+
+struct NumberColumnError {
+  std::size_t field{0};
+  NumberError error{NumberError::Invalid};
+};
+
+namespace detail::num {
+
+// Eight ASCII digits to their value with three multiplies (digits at
+// increasing addresses are decreasing powers of ten).
+inline bool parseEightDigits(const char *p, std::uint32_t &out) noexcept {
+  std::uint64_t v;
+  std::memcpy(&v, p, 8);
+  if constexpr (std::endian::native == std::endian::big) {
+    v = std::byteswap(v);
+  }
+  // Every byte must lie in '0'..'9'.
+  if ((((v & 0xF0F0F0F0F0F0F0F0ull) |
+        (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))) !=
+      0x3333333333333333ull) {
+    return false;
+  }
+  v -= 0x3030303030303030ull;
+  v = (v * 10) + (v >> 8);
+  v = (((v & 0x000000FF000000FFull) * (100 + (1000000ull << 32))) +
+       (((v >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32)))) >>
+      32;
+  out = static_cast<std::uint32_t>(v);
+  return true;
+}
+
+#if DAKT_SIMD_X86
+
+// Sixteen digits: byte pairs, then quads, then octets are combined with
+// multiply-add instructions (pmaddubsw/pmaddwd need SSSE3, so this is
+// gated on the AVX2 level).
+DAKT_TARGET_AVX2 inline bool
+parseSixteenDigitsAvx2(const char *p, std::uint64_t &out) noexcept {
+  const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  const __m128i digits = _mm_sub_epi8(raw, _mm_set1_epi8('0'));
+  const __m128i nine = _mm_set1_epi8(9);
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(digits, nine), nine)) !=
+      0xFFFF) {
+    return false;
+  }
+  const __m128i pairs = _mm_maddubs_epi16(
+      digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1,
+                            10, 1));
+  const __m128i quads = _mm_madd_epi16(
+      pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+  const __m128i packed = _mm_packus_epi32(quads, quads);
+  const __m128i octets = _mm_madd_epi16(
+      packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+  const auto hi = static_cast<std::uint32_t>(_mm_cvtsi128_si32(octets));
+  const auto lo = static_cast<std::uint32_t>(_mm_extract_epi32(octets, 1));
+  out = std::uint64_t{hi} * 100000000u + lo;
+  return true;
+}
+
+#endif // DAKT_SIMD_X86
+
+// Parses up to 19 decimal digits (always fits in 64 bits).
+inline bool parseDigits(const char *p, std::size_t n,
+                        std::uint64_t &out) noexcept {
+  std::uint64_t v = 0;
+  std::size_t i = 0;
+#if DAKT_SIMD_X86
+  if (n >= 16 && simdLevel() == SimdLevel::AVX2) {
+    if (!parseSixteenDigitsAvx2(p, v)) {
+      return false;
+    }
+    i = 16;
+  }
+#endif
+  for (; n - i >= 8; i += 8) {
+    std::uint32_t chunk;
+    if (!parseEightDigits(p + i, chunk)) {
+      return false;
+    }
+    v = v * 100000000u + chunk;
+  }
+  for (; i < n; ++i) {
+    const auto d = static_cast<unsigned>(p[i] - '0');
+    if (d > 9) {
+      return false;
+    }
+    v = v * 10 + d;
+  }
+  out = v;
+  return true;
+}
+
+inline NumberError fromErrc(std::errc ec) noexcept {
+  return ec == std::errc::result_out_of_range ? NumberError::OutOfRange
+                                              : NumberError::Invalid;
+}
+
+inline StringView trimBlanks(StringView s) noexcept {
+  std::size_t begin = 0;
+  std::size_t end = s.size();
+  while (begin < end && (s[begin] == ' ' || s[begin] == '\t')) {
+    ++begin;
+  }
+  while (end > begin &&
+         (s[end - 1] == ' ' || s[end - 1] == '\t' || s[end - 1] == '\r')) {
+    --end;
+  }
+  return s.substr(begin, end - begin);
+}
+
+} // namespace detail::num
+
+// Parses the whole of `text` as an integer. Accepts an optional '-' for
+// signed types and nothing else besides digits (no '+', whitespace or
+// prefixes), like std::from_chars. Base-10 input of up to 19 digits is parsed
+// in 8/16-digit blocks; everything else goes through std::from_chars.
+template <std::integral T>
+  requires(!std::same_as<T, bool>)
+[[nodiscard]] Result<T, NumberError> parseInt(StringView text,
+                                              int base = 10) noexcept {
+  using R = Result<T, NumberError>;
+  if (text.empty()) {
+    return R::err(NumberError::Empty);
+  }
+  const bool negative = std::is_signed_v<T> && text[0] == '-';
+  const std::size_t digits = text.size() - (negative ? 1 : 0);
+  if (base == 10 && digits > 0 && digits <= 19) {
+    std::uint64_t magnitude;
+    if (!detail::num::parseDigits(text.data() + (negative ? 1 : 0), digits,
+                                  magnitude)) {
+      return R::err(NumberError::Invalid);
+    }
+    using U = std::make_unsigned_t<T>;
+    const std::uint64_t limit =
+        std::uint64_t{static_cast<U>(std::numeric_limits<T>::max())} +
+        (negative ? 1 : 0);
+    if (magnitude > limit) {
+      return R::err(NumberError::OutOfRange);
+    }
+    if (negative) {
+      return R::ok(static_cast<T>(
+          static_cast<std::int64_t>(std::uint64_t{0} - magnitude)));
+    }
+    return R::ok(static_cast<T>(magnitude));
+  }
+  T value{};
+  const char *last = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), last, value, base);
+  if (ec != std::errc{}) {
+    return R::err(detail::num::fromErrc(ec));
+  }
+  if (ptr != last) {
+    return R::err(NumberError::Invalid);
+  }
+  return R::ok(value);
+}
+
+// Parses the whole of `text` as a floating-point number with
+// std::from_chars (locale-independent, correctly rounded).
+template <std::floating_point T>
+[[nodiscard]] Result<T, NumberError>
+parseFloat(StringView text,
+           std::chars_format format = std::chars_format::general) noexcept {
+  using R = Result<T, NumberError>;
+  if (text.empty()) {
+    return R::err(NumberError::Empty);
+  }
+  T value{};
+  const char *last = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), last, value, format);
+  if (ec != std::errc{}) {
+    return R::err(detail::num::fromErrc(ec));
+  }
+  if (ptr != last) {
+    return R::err(NumberError::Invalid);
+  }
+  return R::ok(value);
+}
+
+// Writes `value` into `out` (no terminator) and returns the length. Floating
+// point values use the shortest representation that round-trips.
+template <typename T>
+  requires(std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+[[nodiscard]] Result<std::size_t, NumberError>
+formatNumber(T value, Span<char> out) noexcept {
+  using R = Result<std::size_t, NumberError>;
+  const auto [ptr, ec] =
+      std::to_chars(out.data(), out.data() + out.size(), value);
+  if (ec != std::errc{}) {
+    return R::err(NumberError::BufferTooSmall);
+  }
+  return R::ok(static_cast<std::size_t>(ptr - out.data()));
+}
+
+template <std::floating_point T>
+[[nodiscard]] Result<std::size_t, NumberError>
+formatNumber(T value, Span<char> out, std::chars_format format,
+             int precision) noexcept {
+  using R = Result<std::size_t, NumberError>;
+  const auto [ptr, ec] = std::to_chars(out.data(), out.data() + out.size(),
+                                       value, format, precision);
+  if (ec != std::errc{}) {
+    return R::err(NumberError::BufferTooSmall);
+  }
+  return R::ok(static_cast<std::size_t>(ptr - out.data()));
+}
+
+// Large enough for any integer or shortest-form floating-point value.
+using NumberString = InlineString<48>;
+
+template <typename T>
+  requires(std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+[[nodiscard]] NumberString formatNumber(T value) noexcept {
+  char buf[NumberString::capacity()];
+  const auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+  return NumberString(
+      StringView(buf, ec == std::errc{} ? static_cast<std::size_t>(ptr - buf)
+                                        : 0));
+}
+
+// Parses every `delim`-separated field of `text` into `out` and returns the
+// field count. Spaces and tabs around a field (and a trailing '\r') are
+// ignored. Stops at the first bad field and reports its index; a column with
+// more fields than `out` holds fails with BufferTooSmall.
+template <typename T>
+  requires(std::is_arithmetic_v<T> && !std::same_as<T, bool>)
+[[nodiscard]] Result<std::size_t, NumberColumnError>
+parseColumn(StringView text, char delim, Span<T> out) noexcept {
+  using R = Result<std::size_t, NumberColumnError>;
+  std::size_t n = 0;
+  for (const StringView raw : split(text, delim)) {
+    if (n == out.size()) {
+      return R::err({n, NumberError::BufferTooSmall});
+    }
+    const StringView field = detail::num::trimBlanks(raw);
+    if constexpr (std::is_floating_point_v<T>) {
+      const auto r = parseFloat<T>(field);
+      if (r.isErr()) {
+        return R::err({n, r.error()});
+      }
+      out[n] = r.value();
+    } else {
+      const auto r = parseInt<T>(field);
+      if (r.isErr()) {
+        return R::err({n, r.error()});
+      }
+      out[n] = r.value();
+    }
+    ++n;
+  }
+  return R::ok(n);
+}
+
+} // namespace dakt::core
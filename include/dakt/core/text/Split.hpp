@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "../types/StringView.hpp"
+#include "StringSearch.hpp"
+
+namespace dakt::core {
+
+namespace detail::split {
+
+struct Cut {
+  std::size_t end;  // end of the token, npos when the rest is one token
+  std::size_t next; // start of the following token
+};
+
+// Each finder locates the next delimiter in `rest`. Single delimiters go
+// through StringView::find (memchr), sets through findFirstOfSimd.
+
+constexpr std::size_t findAny(StringView rest, StringView set) noexcept {
+  if consteval {
+    return rest.findFirstOf(set);
+  } else {
+    return findFirstOfSimd(rest, set);
+  }
+}
+
+struct ByChar {
+  static constexpr bool kSkipEmpty = false;
+  static constexpr bool kDropTrailingEmpty = false;
+  char delim;
+
+  constexpr std::size_t skip(StringView) const noexcept { return 0; }
+  constexpr Cut cut(StringView rest) const noexcept {
+    const std::size_t i = rest.find(delim);
+    return {i, i == StringView::npos ? i : i + 1};
+  }
+};
+
+struct ByAny {
+  static constexpr bool kSkipEmpty = false;
+  static constexpr bool kDropTrailingEmpty = false;
+  StringView delims;
+
+  constexpr std::size_t skip(StringView) const noexcept { return 0; }
+  constexpr Cut cut(StringView rest) const noexcept {
+    const std::size_t i = findAny(rest, delims);
+    return {i, i == StringView::npos ? i : i + 1};
+  }
+};
+
+// '\n' separated, with a trailing '\r' stripped from each line and no empty
+// line reported after a final terminator.
+struct ByLine {
+  static constexpr bool kSkipEmpty = false;
+  static constexpr bool kDropTrailingEmpty = true;
+
+  constexpr std::size_t skip(StringView) const noexcept { return 0; }
+  constexpr Cut cut(StringView rest) const noexcept {
+    const std::size_t i = rest.find('\n');
+    if (i == StringView::npos) {
+      const bool cr = !rest.empty() && rest[rest.size() - 1] == '\r';
+      return {cr ? rest.size() - 1 : i, i};
+    }
+    const bool cr = i > 0 && rest[i - 1] == '\r';
+    return {cr ? i - 1 : i, i + 1};
+  }
+};
+
+// Runs of ASCII whitespace separate tokens; empty tokens are never produced.
+struct ByWhitespace {
+  static constexpr bool kSkipEmpty = true;
+  static constexpr bool kDropTrailingEmpty = true;
+  static constexpr StringView kSpace{" \t\n\r\f\v", 6};
+
+  constexpr std::size_t skip(StringView rest) const noexcept {
+    const std::size_t i = rest.findFirstNotOf(kSpace);
+    return i == StringView::npos ? rest.size() : i;
+  }
+  constexpr Cut cut(StringView rest) const noexcept {
+    const std::size_t i = findAny(rest, kSpace);
+    return {i, i == StringView::npos ? i : i + 1};
+  }
+};
+
+} // namespace detail::split
+
+// Lazy, allocation-free range of the tokens of a StringView. Tokens are views
+// into the original text.
+template <typename Finder> class SplitRange {
+public:
+  class Iterator {
+  public:
+    using value_type = StringView;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr Iterator() noexcept = default;
+    constexpr Iterator(StringView text, Finder finder) noexcept
+        : rest_(text), finder_(finder), pending_(!text.empty()) {
+      advance();
+    }
+
+    [[nodiscard]] constexpr StringView operator*() const noexcept {
+      return current_;
+    }
+
+    constexpr Iterator &operator++() noexcept {
+      advance();
+      return *this;
+    }
+    constexpr Iterator operator++(int) noexcept {
+      Iterator tmp = *this;
+      advance();
+      return tmp;
+    }
+
+    [[nodiscard]] constexpr bool
+    operator==(const Iterator &other) const noexcept {
+      return atEnd_ == other.atEnd_ &&
+             (atEnd_ || current_.data() == other.current_.data());
+    }
+    [[nodiscard]] constexpr bool
+    operator==(std::default_sentinel_t) const noexcept {
+      return atEnd_;
+    }
+
+  private:
+    constexpr void advance() noexcept {
+      if (!pending_) {
+        atEnd_ = true;
+        return;
+      }
+      rest_ = rest_.substr(finder_.skip(rest_));
+      if (Finder::kSkipEmpty && rest_.empty()) {
+        pending_ = false;
+        atEnd_ = true;
+        return;
+      }
+      atEnd_ = false;
+      const detail::split::Cut c = finder_.cut(rest_);
+      if (c.next == StringView::npos) {
+        current_ = rest_.substr(0, c.end);
+        pending_ = false;
+        return;
+      }
+      current_ = rest_.substr(0, c.end);
+      rest_ = rest_.substr(c.next);
+      if (Finder::kDropTrailingEmpty && rest_.empty()) {
+        pending_ = false;
+      }
+    }
+
+    StringView rest_{};
+    StringView current_{};
+    Finder finder_{};
+    bool pending_{false};
+    bool atEnd_{true};
+  };
+
+  constexpr SplitRange(StringView text, Finder finder) noexcept
+      : text_(text), finder_(finder) {}
+
+  [[nodiscard]] constexpr Iterator begin() const noexcept {
+    return Iterator(text_, finder_);
+  }
+  [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept {
+    return {};
+  }
+
+  // Number of tokens; walks the range.
+  [[nodiscard]] constexpr std::size_t count() const noexcept {
+    std::size_t n = 0;
+    for (Iterator it = begin(); it != end(); ++it) {
+      ++n;
+    }
+    return n;
+  }
+
+private:
+  StringView text_;
+  Finder finder_;
+};
+
+// "a,,b" -> "a", "", "b". Empty input yields no tokens.
+[[nodiscard]] constexpr SplitRange<detail::split::ByChar>
+split(StringView text, char delim) noexcept {
+  return {text, detail::split::ByChar{delim}};
+}
+
+// Splits at any character of `delims`.
+[[nodiscard]] constexpr SplitRange<detail::split::ByAny>
+splitAny(StringView text, StringView delims) noexcept {
+  return {text, detail::split::ByAny{delims}};
+}
+
+[[nodiscard]] constexpr SplitRange<detail::split::ByLine>
+splitLines(StringView text) noexcept {
+  return {text, detail::split::ByLine{}};
+}
+
+[[nodiscard]] constexpr SplitRange<detail::split::ByWhitespace>
+splitWhitespace(StringView text) noexcept {
+  return {text, detail::split::ByWhitespace{}};
+}
+
+} // namespace dakt::core
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+namespace dakt::core {
+
+// One contiguous piece of a builder's contents. Field order and types match
+// POSIX `struct iovec`, so a Span<IoSlice> can be handed to writev().
+struct IoSlice {
+  const void *base{nullptr};
+  std::size_t length{0};
+};
+
+// Appends into a chain of chunks allocated from an IAllocator, so growing
+// never copies what was already written. finish() produces one contiguous
+// view (copying only when more than one chunk is in use); slices() exposes the
+// chunks as-is for vectored I/O. clear() keeps the chunks for reuse.
+class StringBuilder {
+public:
+  static constexpr std::size_t kDefaultChunkSize = 4096;
+
+  // Output iterator for std::format_to and std algorithms.
+  class Appender {
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    Appender() noexcept = default;
+    explicit Appender(StringBuilder &owner) noexcept : owner_(&owner) {}
+
+    Appender &operator=(char c) {
+      owner_->append(c);
+      return *this;
+    }
+    Appender &operator*() noexcept { return *this; }
+    Appender &operator++() noexcept { return *this; }
+    Appender operator++(int) noexcept { return *this; }
+
+  private:
+    StringBuilder *owner_{nullptr};
+  };
+
+  explicit StringBuilder(IAllocator &allocator,
+                         std::size_t chunkSize = kDefaultChunkSize) noexcept
+      : allocator_(&allocator),
+        chunkSize_(std::max<std::size_t>(chunkSize, 64)) {}
+
+  ~StringBuilder() { release(); }
+
+  StringBuilder(const StringBuilder &) = delete;
+  StringBuilder &operator=(const StringBuilder &) = delete;
+
+  StringBuilder(StringBuilder &&other) noexcept
+      : allocator_(other.allocator_), chunkSize_(other.chunkSize_),
+        head_(std::exchange(other.head_, nullptr)),
+        tail_(std::exchange(other.tail_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        flat_(std::exchange(other.flat_, nullptr)),
+        flatCapacity_(std::exchange(other.flatCapacity_, 0)) {}
+
+  StringBuilder &operator=(StringBuilder &&other) noexcept {
+    if (this != &other) {
+      release();
+      allocator_ = other.allocator_;
+      chunkSize_ = other.chunkSize_;
+      head_ = std::exchange(other.head_, nullptr);
+      tail_ = std::exchange(other.tail_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      flat_ = std::exchange(other.flat_, nullptr);
+      flatCapacity_ = std::exchange(other.flatCapacity_, 0);
+    }
+    return *this;
+  }
+
+  StringBuilder &append(char c) {
+    if (tail_ == nullptr || tail_->used == tail_->capacity) {
+      grow(1);
+    }
+    tail_->data()[tail_->used++] = c;
+    ++size_;
+    return *this;
+  }
+
+  StringBuilder &append(StringView text) {
+    const char *src = text.data();
+    std::size_t left = text.size();
+    while (left > 0) {
+      if (tail_ == nullptr || tail_->used == tail_->capacity) {
+        grow(left);
+      }
+      const std::size_t n = std::min(left, tail_->capacity - tail_->used);
+      std::memcpy(tail_->data() + tail_->used, src, n);
+      tail_->used += n;
+      src += n;
+      left -= n;
+    }
+    size_ += text.size();
+    return *this;
+  }
+
+  StringBuilder &append(std::size_t count, char c) {
+    while (count > 0) {
+      if (tail_ == nullptr || tail_->used == tail_->capacity) {
+        grow(count);
+      }
+      const std::size_t n = std::min(count, tail_->capacity - tail_->used);
+      std::memset(tail_->data() + tail_->used, c, n);
+      tail_->used += n;
+      size_ += n;
+      count -= n;
+    }
+    return *this;
+  }
+
+  // Formats directly into the chunks; no temporary string is built.
+  template <typename... Args>
+  StringBuilder &appendFormat(std::format_string<Args...> fmt,
+                              Args &&...args) {
+    std::format_to(appender(), fmt, std::forward<Args>(args)...);
+    return *this;
+  }
+
+  [[nodiscard]] Appender appender() noexcept { return Appender(*this); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  // Number of slices slices() would write.
+  [[nodiscard]] std::size_t sliceCount() const noexcept {
+    std::size_t n = 0;
+    for (const Chunk *c = head_; c != nullptr && c->used > 0; c = c->next) {
+      ++n;
+    }
+    return n;
+  }
+
+  // Writes up to out.size() slices covering the contents in order and
+  // returns how many were written. Valid until the builder is next modified.
+  std::size_t slices(Span<IoSlice> out) const noexcept {
+    std::size_t n = 0;
+    for (const Chunk *c = head_; c != nullptr && c->used > 0 && n < out.size();
+         c = c->next) {
+      out[n++] = IoSlice{c->data(), c->used};
+    }
+    return n;
+  }
+
+  // The whole contents as one view. Free when everything fits in the first
+  // chunk; otherwise the chunks are copied once into a flat buffer owned by
+  // the builder. Valid until the builder is next modified.
+  [[nodiscard]] StringView finish() {
+    if (head_ == nullptr) {
+      return {};
+    }
+    if (head_->used == size_) {
+      return StringView(head_->data(), size_);
+    }
+    if (flatCapacity_ < size_) {
+      if (flat_ != nullptr) {
+        allocator_->deallocate(flat_, flatCapacity_);
+      }
+      flat_ = static_cast<char *>(allocator_->allocate(size_, 1));
+      flatCapacity_ = size_;
+    }
+    char *out = flat_;
+    for (const Chunk *c = head_; c != nullptr && c->used > 0; c = c->next) {
+      std::memcpy(out, c->data(), c->used);
+      out += c->used;
+    }
+    return StringView(flat_, size_);
+  }
+
+  // Drops the contents but keeps every chunk for reuse.
+  void clear() noexcept {
+    for (Chunk *c = head_; c != nullptr; c = c->next) {
+      c->used = 0;
+    }
+    tail_ = head_;
+    size_ = 0;
+  }
+
+private:
+  struct Chunk {
+    Chunk *next;
+    std::size_t capacity;
+    std::size_t used;
+
+    [[nodiscard]] char *data() noexcept {
+      return reinterpret_cast<char *>(this + 1);
+    }
+    [[nodiscard]] const char *data() const noexcept {
+      return reinterpret_cast<const char *>(this + 1);
+    }
+  };
+
+  // Moves to the next chunk, reusing one left by clear() or allocating one
+  // big enough for `hint` bytes (but at least the chunk size).
+  void grow(std::size_t hint) {
+    if (tail_ != nullptr && tail_->next != nullptr) {
+      tail_ = tail_->next;
+      return;
+    }
+    const std::size_t capacity = std::max(chunkSize_, hint);
+    auto *chunk = static_cast<Chunk *>(
+        allocator_->allocate(sizeof(Chunk) + capacity, alignof(Chunk)));
+    chunk->next = nullptr;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    if (tail_ == nullptr) {
+      head_ = chunk;
+    } else {
+      tail_->next = chunk;
+    }
+    tail_ = chunk;
+  }
+
+  void release() noexcept {
+    for (Chunk *c = head_; c != nullptr;) {
+      Chunk *next = c->next;
+      allocator_->deallocate(c, sizeof(Chunk) + c->capacity);
+      c = next;
+    }
+    if (flat_ != nullptr) {
+      allocator_->deallocate(flat_, flatCapacity_);
+    }
+    head_ = tail_ = nullptr;
+    flat_ = nullptr;
+    size_ = flatCapacity_ = 0;
+  }
+
+  IAllocator *allocator_;
+  std::size_t chunkSize_;
+  Chunk *head_{nullptr};
+  Chunk *tail_{nullptr};
+  std::size_t size_{0};
+  char *flat_{nullptr};
+  std::size_t flatCapacity_{0};
+};
+
+} // namespace dakt::core
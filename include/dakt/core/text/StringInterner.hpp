@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+#include "../hash/Hash.hpp"
+#include "../interfaces/IAllocator.hpp"
+#include "../types/StringView.hpp"
+#include "../types/Symbol.hpp"
+
+namespace dakt::core {
+
+// Stores each distinct string once, in arena blocks from an IAllocator, and
+// hands out 32-bit symbols. Views returned by view() stay valid for the
+// lifetime of the interner.
+//
+// The key space is split into shards by hash. find() and view() take no lock:
+// hash tables and symbol directories are published with release stores and
+// never modified in place once readers can see a slot. intern() locks only
+// the owning shard. Hash tables outgrown by a shard are kept until the
+// interner is destroyed, since a reader may still be probing one; this costs
+// at most as much again as the live table.
+class StringInterner {
+public:
+  static constexpr std::uint32_t kShardBits = 4;
+  static constexpr std::uint32_t kShards = 1u << kShardBits;
+  static constexpr std::uint32_t kIndexBits = 32 - kShardBits;
+  static constexpr std::uint32_t kMaxPerShard = (1u << kIndexBits) - 1;
+
+  explicit StringInterner(IAllocator &allocator) noexcept
+      : allocator_(allocator) {}
+  ~StringInterner();
+
+  StringInterner(const StringInterner &) = delete;
+  StringInterner &operator=(const StringInterner &) = delete;
+
+  // Returns the symbol for `text`, adding it if needed. `textHash` must be
+  // hash(text), e.g. computed once at compile time with ""_hash.
+  Symbol intern(StringView text) { return intern(text, hash(text)); }
+  Symbol intern(StringView text, std::uint64_t textHash);
+
+  // Returns the symbol for `text` if it has been interned, or Symbol{}.
+  [[nodiscard]] Symbol find(StringView text) const noexcept {
+    return find(text, hash(text));
+  }
+  [[nodiscard]] Symbol find(StringView text,
+                            std::uint64_t textHash) const noexcept {
+    const Entry *e = shards_[shardOf(textHash)].lookup(text, textHash);
+    return e != nullptr ? Symbol{e->id} : Symbol{};
+  }
+
+  // The string of a symbol from this interner; empty for Symbol{}. The view
+  // is null-terminated.
+  [[nodiscard]] StringView view(Symbol symbol) const noexcept {
+    if (!symbol.valid()) {
+      return {};
+    }
+    const Shard &shard = shards_[symbol.value >> kIndexBits];
+    const Entry *e = shard.entryAt((symbol.value & kMaxPerShard) - 1);
+    return e != nullptr ? StringView(e->chars(), e->length) : StringView{};
+  }
+
+  [[nodiscard]] std::uint64_t hashOf(Symbol symbol) const noexcept {
+    if (!symbol.valid()) {
+      return hash(StringView{});
+    }
+    const Shard &shard = shards_[symbol.value >> kIndexBits];
+    const Entry *e = shard.entryAt((symbol.value & kMaxPerShard) - 1);
+    return e != nullptr ? e->hash : hash(StringView{});
+  }
+
+  // Number of distinct strings interned so far.
+  [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+  struct Entry {
+    std::uint64_t hash;
+    std::uint32_t id;
+    std::uint32_t length;
+
+    [[nodiscard]] const char *chars() const noexcept {
+      return reinterpret_cast<const char *>(this + 1);
+    }
+  };
+
+  using EntrySlot = std::atomic<const Entry *>;
+
+  // Open-addressed table of entry pointers; linear probing, at most half full.
+  struct Table {
+    std::size_t mask;
+    EntrySlot *slots;
+    Table *retired; // previous, smaller table
+  };
+
+  struct Block {
+    Block *next;
+    std::size_t size;
+  };
+
+  // Symbol directory: segment k holds 64 << k entries, so indexes never move
+  // and the directory never needs reallocating.
+  static constexpr std::size_t kFirstSegment = 64;
+  static constexpr std::size_t kSegments = kIndexBits - 5;
+
+  struct alignas(64) Shard {
+    std::atomic<const Table *> table{nullptr};
+    std::atomic<EntrySlot *> segments[kSegments]{};
+    std::atomic<std::uint32_t> count{0};
+
+    std::mutex writeMutex;
+    Block *blocks{nullptr};
+    char *cursor{nullptr};
+    std::size_t remaining{0};
+
+    [[nodiscard]] const Entry *lookup(StringView text,
+                                      std::uint64_t textHash) const noexcept {
+      const Table *t = table.load(std::memory_order_acquire);
+      if (t == nullptr) {
+        return nullptr;
+      }
+      for (std::size_t i = textHash & t->mask;; i = (i + 1) & t->mask) {
+        const Entry *e = t->slots[i].load(std::memory_order_acquire);
+        if (e == nullptr) {
+          return nullptr;
+        }
+        if (e->hash == textHash && e->length == text.size() &&
+            (text.empty() ||
+             std::memcmp(e->chars(), text.data(), text.size()) == 0)) {
+          return e;
+        }
+      }
+    }
+
+    [[nodiscard]] const Entry *entryAt(std::uint32_t index) const noexcept {
+      const std::size_t j = std::size_t{index} + kFirstSegment;
+      const auto k = static_cast<std::size_t>(std::bit_width(j)) - 7;
+      if (k >= kSegments) {
+        return nullptr;
+      }
+      const EntrySlot *segment = segments[k].load(std::memory_order_acquire);
+      if (segment == nullptr) {
+        return nullptr;
+      }
+      return segment[j - (kFirstSegment << k)].load(std::memory_order_acquire);
+    }
+  };
+
+  [[nodiscard]] static std::uint32_t shardOf(std::uint64_t h) noexcept {
+    return static_cast<std::uint32_t>(h >> (64 - kShardBits));
+  }
+
+  const Entry *store(Shard &shard, StringView text, std::uint64_t textHash,
+                     std::uint32_t id);
+  void publishEntry(Shard &shard, std::uint32_t index, const Entry *e);
+  void insertIntoTable(Shard &shard, const Entry *e);
+  Table *makeTable(std::size_t capacity);
+  void freeTable(const Table *t) noexcept;
+
+  IAllocator &allocator_;
+  Shard shards_[kShards];
+};
+
+} // namespace dakt::core
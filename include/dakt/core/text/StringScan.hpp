@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+// Portable run-time search loops behind StringView: memchr/memcmp and a byte
+// table, no intrinsics, so every translation unit using StringView stays
+// cheap to compile. They work on raw pointer/length pairs so StringView can
+// include them without a cycle; the constexpr scalar loops stay in
+// StringView for constant evaluation. SSE2/AVX2 versions for hot paths are
+// in StringSearch.hpp.
+namespace dakt::core::detail::strsearch {
+
+inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+[[nodiscard]] inline std::size_t findChar(const char *s, std::size_t n,
+                                          char c) noexcept {
+  if (n == 0) {
+    return npos;
+  }
+  // libc memchr is already vectorized on every platform we target.
+  const void *hit = std::memchr(s, static_cast<unsigned char>(c), n);
+  return hit == nullptr ? npos
+                        : static_cast<std::size_t>(
+                              static_cast<const char *>(hit) - s);
+}
+
+[[nodiscard]] inline std::size_t rfindChar(const char *s, std::size_t n,
+                                           char c) noexcept {
+  while (n-- > 0) {
+    if (s[n] == c) {
+      return n;
+    }
+  }
+  return npos;
+}
+
+[[nodiscard]] inline bool equalTail(const char *a, const char *b,
+                                    std::size_t n) noexcept {
+  return n == 0 || std::memcmp(a, b, n) == 0;
+}
+
+// Checks every start position from `from` on; m must be at least 2.
+[[nodiscard]] inline std::size_t findScalar(const char *s, std::size_t n,
+                                            const char *needle,
+                                            std::size_t m,
+                                            std::size_t from) noexcept {
+  for (std::size_t i = from; i + m <= n; ++i) {
+    if (s[i] == needle[0] && s[i + m - 1] == needle[m - 1] &&
+        equalTail(s + i + 1, needle + 1, m - 2)) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+// First occurrence of needle[0, m) in s[0, n); m must be at least 1.
+// Candidates come from memchr on the needle's first byte.
+[[nodiscard]] inline std::size_t find(const char *s, std::size_t n,
+                                      const char *needle,
+                                      std::size_t m) noexcept {
+  if (m > n) {
+    return npos;
+  }
+  const std::size_t starts = n - m + 1;
+  for (std::size_t i = 0; i < starts; ++i) {
+    const std::size_t hit = findChar(s + i, starts - i, needle[0]);
+    if (hit == npos) {
+      return npos;
+    }
+    i += hit;
+    if (equalTail(s + i + 1, needle + 1, m - 1)) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+// Last occurrence of needle[0, m) in s[0, n); m must be at least 1. Walks
+// candidate start positions backwards with `rfindCharFn`.
+template <typename RfindChar>
+[[nodiscard]] std::size_t rfindWith(RfindChar rfindCharFn, const char *s,
+                                    std::size_t n, const char *needle,
+                                    std::size_t m) noexcept {
+  if (m > n) {
+    return npos;
+  }
+  std::size_t limit = n - m + 1;
+  while (limit > 0) {
+    const std::size_t i = rfindCharFn(s, limit, needle[0]);
+    if (i == npos) {
+      return npos;
+    }
+    if (equalTail(s + i + 1, needle + 1, m - 1)) {
+      return i;
+    }
+    limit = i;
+  }
+  return npos;
+}
+
+[[nodiscard]] inline std::size_t rfind(const char *s, std::size_t n,
+                                       const char *needle,
+                                       std::size_t m) noexcept {
+  return rfindWith(&rfindChar, s, n, needle, m);
+}
+
+// Byte membership table for character sets.
+struct ByteSet {
+  bool bits[256]{};
+
+  ByteSet(const char *set, std::size_t k) noexcept {
+    for (std::size_t j = 0; j < k; ++j) {
+      bits[static_cast<unsigned char>(set[j])] = true;
+    }
+  }
+
+  [[nodiscard]] bool contains(char c) const noexcept {
+    return bits[static_cast<unsigned char>(c)];
+  }
+};
+
+// First s[i] in `set`; k must be at least 2.
+[[nodiscard]] inline std::size_t findFirstOfTable(const char *s, std::size_t n,
+                                                  const char *set,
+                                                  std::size_t k) noexcept {
+  const ByteSet table(set, k);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (table.contains(s[i])) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+[[nodiscard]] inline std::size_t findFirstOf(const char *s, std::size_t n,
+                                             const char *set,
+                                             std::size_t k) noexcept {
+  if (k == 0 || n == 0) {
+    return npos;
+  }
+  if (k == 1) {
+    return findChar(s, n, set[0]);
+  }
+  return findFirstOfTable(s, n, set, k);
+}
+
+[[nodiscard]] inline std::size_t findLastOf(const char *s, std::size_t n,
+                                            const char *set,
+                                            std::size_t k) noexcept {
+  if (k == 0) {
+    return npos;
+  }
+  if (k == 1) {
+    return rfindChar(s, n, set[0]);
+  }
+  const ByteSet table(set, k);
+  while (n-- > 0) {
+    if (table.contains(s[n])) {
+      return n;
+    }
+  }
+  return npos;
+}
+
+[[nodiscard]] inline std::size_t findFirstNotOf(const char *s, std::size_t n,
+                                                const char *set,
+                                                std::size_t k) noexcept {
+  const ByteSet table(set, k);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!table.contains(s[i])) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+} // namespace dakt::core::detail::strsearch
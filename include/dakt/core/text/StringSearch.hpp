@@ -0,0 +1,278 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "../platform/Simd.hpp"
+#include "../types/StringView.hpp"
+#include "StringScan.hpp"
+
+// SSE2/AVX2 string search for hot paths, picked by simdLevel() at run time.
+// StringView's members use the portable loops in StringScan.hpp so that
+// headers using StringView do not pull in intrinsics; callers that scan long
+// texts include this header and use the *Simd functions below instead.
+namespace dakt::core {
+
+namespace detail::strsearch {
+
+#if DAKT_SIMD_X86
+
+DAKT_TARGET_SSE2 inline std::size_t rfindCharSse2(const char *s,
+                                                  std::size_t n,
+                                                  char c) noexcept {
+  const __m128i needle = _mm_set1_epi8(c);
+  while (n >= 16) {
+    n -= 16;
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + n));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+    if (mask != 0) {
+      return n + 31 - static_cast<std::size_t>(std::countl_zero(mask));
+    }
+  }
+  return rfindChar(s, n, c);
+}
+
+DAKT_TARGET_AVX2 inline std::size_t rfindCharAvx2(const char *s,
+                                                  std::size_t n,
+                                                  char c) noexcept {
+  const __m256i needle = _mm256_set1_epi8(c);
+  while (n >= 32) {
+    n -= 32;
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + n));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+    if (mask != 0) {
+      return n + 31 - static_cast<std::size_t>(std::countl_zero(mask));
+    }
+  }
+  return rfindChar(s, n, c);
+}
+
+// Substring search by first/last byte filtering: compare the needle's first
+// and last byte against 16 or 32 candidate positions at once and only run
+// memcmp on positions where both match.
+DAKT_TARGET_SSE2 inline std::size_t findSse2(const char *s, std::size_t n,
+                                             const char *needle,
+                                             std::size_t m) noexcept {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[m - 1]);
+  std::size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    const __m128i blockFirst =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    const __m128i blockLast =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+    while (mask != 0) {
+      const auto bit = static_cast<std::size_t>(std::countr_zero(mask));
+      if (equalTail(s + i + bit + 1, needle + 1, m - 2)) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return findScalar(s, n, needle, m, i);
+}
+
+DAKT_TARGET_AVX2 inline std::size_t findAvx2(const char *s, std::size_t n,
+                                             const char *needle,
+                                             std::size_t m) noexcept {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+  std::size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    const __m256i blockFirst =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    const __m256i blockLast =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i + m - 1));
+    auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(first, blockFirst),
+            _mm256_cmpeq_epi8(last, blockLast))));
+    while (mask != 0) {
+      const auto bit = static_cast<std::size_t>(std::countr_zero(mask));
+      if (equalTail(s + i + bit + 1, needle + 1, m - 2)) {
+        return i + bit;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return findScalar(s, n, needle, m, i);
+}
+
+// Tail of the small-set kernels: under one block, so comparing against each
+// member beats building a ByteSet.
+inline std::size_t findAnyTail(const char *s, std::size_t n, const char *set,
+                               std::size_t k, std::size_t from) noexcept {
+  for (std::size_t i = from; i < n; ++i) {
+    for (std::size_t j = 0; j < k; ++j) {
+      if (s[i] == set[j]) {
+        return i;
+      }
+    }
+  }
+  return npos;
+}
+
+// Small character sets: one broadcast compare per set member per block.
+DAKT_TARGET_AVX2 inline std::size_t findAnyAvx2(const char *s, std::size_t n,
+                                                const char *set,
+                                                std::size_t k) noexcept {
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i));
+    __m256i hit = _mm256_setzero_si256();
+    for (std::size_t j = 0; j < k; ++j) {
+      hit = _mm256_or_si256(hit,
+                            _mm256_cmpeq_epi8(block, _mm256_set1_epi8(set[j])));
+    }
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return findAnyTail(s, n, set, k, i);
+}
+
+DAKT_TARGET_SSE2 inline std::size_t findAnySse2(const char *s, std::size_t n,
+                                                const char *set,
+                                                std::size_t k) noexcept {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    __m128i hit = _mm_setzero_si128();
+    for (std::size_t j = 0; j < k; ++j) {
+      hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, _mm_set1_epi8(set[j])));
+    }
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(hit));
+    if (mask != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(mask));
+    }
+  }
+  return findAnyTail(s, n, set, k, i);
+}
+
+#endif // DAKT_SIMD_X86
+
+[[nodiscard]] inline std::size_t rfindCharFast(const char *s, std::size_t n,
+                                               char c) noexcept {
+#if DAKT_SIMD_X86
+  switch (simdLevel()) {
+  case SimdLevel::AVX2:
+    return rfindCharAvx2(s, n, c);
+  case SimdLevel::SSE2:
+    return rfindCharSse2(s, n, c);
+  case SimdLevel::Scalar:
+    break;
+  }
+#endif
+  return rfindChar(s, n, c);
+}
+
+// First occurrence of needle[0, m) in s[0, n); m must be at least 1.
+[[nodiscard]] inline std::size_t findFast(const char *s, std::size_t n,
+                                          const char *needle,
+                                          std::size_t m) noexcept {
+  if (m > n) {
+    return npos;
+  }
+  if (m == 1) {
+    return findChar(s, n, needle[0]);
+  }
+#if DAKT_SIMD_X86
+  switch (simdLevel()) {
+  case SimdLevel::AVX2:
+    return findAvx2(s, n, needle, m);
+  case SimdLevel::SSE2:
+    return findSse2(s, n, needle, m);
+  case SimdLevel::Scalar:
+    break;
+  }
+#endif
+  return find(s, n, needle, m);
+}
+
+inline constexpr std::size_t kSmallSet = 8;
+
+[[nodiscard]] inline std::size_t findFirstOfFast(const char *s, std::size_t n,
+                                                 const char *set,
+                                                 std::size_t k) noexcept {
+  if (k == 0 || n == 0) {
+    return npos;
+  }
+  if (k == 1) {
+    return findChar(s, n, set[0]);
+  }
+#if DAKT_SIMD_X86
+  if (k <= kSmallSet) {
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      return findAnyAvx2(s, n, set, k);
+    case SimdLevel::SSE2:
+      return findAnySse2(s, n, set, k);
+    case SimdLevel::Scalar:
+      break;
+    }
+  }
+#endif
+  return findFirstOfTable(s, n, set, k);
+}
+
+} // namespace detail::strsearch
+
+// The same results as StringView::find, rfind and findFirstOf.
+
+[[nodiscard]] inline std::size_t
+findSimd(StringView text, StringView needle, std::size_t pos = 0) noexcept {
+  if (needle.empty()) {
+    return pos <= text.size() ? pos : StringView::npos;
+  }
+  if (pos > text.size() || needle.size() > text.size() - pos) {
+    return StringView::npos;
+  }
+  const std::size_t i = detail::strsearch::findFast(
+      text.data() + pos, text.size() - pos, needle.data(), needle.size());
+  return i == StringView::npos ? StringView::npos : pos + i;
+}
+
+[[nodiscard]] inline std::size_t
+rfindSimd(StringView text, char c,
+          std::size_t pos = StringView::npos) noexcept {
+  const std::size_t n = pos < text.size() ? pos + 1 : text.size();
+  return detail::strsearch::rfindCharFast(text.data(), n, c);
+}
+
+[[nodiscard]] inline std::size_t
+rfindSimd(StringView text, StringView needle,
+          std::size_t pos = StringView::npos) noexcept {
+  if (needle.size() > text.size()) {
+    return StringView::npos;
+  }
+  const std::size_t maxStart = text.size() - needle.size();
+  const std::size_t last = maxStart < pos ? maxStart : pos;
+  if (needle.empty()) {
+    return last;
+  }
+  return detail::strsearch::rfindWith(&detail::strsearch::rfindCharFast,
+                                      text.data(), last + needle.size(),
+                                      needle.data(), needle.size());
+}
+
+[[nodiscard]] inline std::size_t
+findFirstOfSimd(StringView text, StringView set, std::size_t pos = 0) noexcept {
+  if (pos >= text.size()) {
+    return StringView::npos;
+  }
+  const std::size_t i = detail::strsearch::findFirstOfFast(
+      text.data() + pos, text.size() - pos, set.data(), set.size());
+  return i == StringView::npos ? StringView::npos : pos + i;
+}
+
+} // namespace dakt::core
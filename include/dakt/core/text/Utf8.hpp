@@ -0,0 +1,464 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../platform/Simd.hpp"
+#include "../types/ErrorCode.hpp"
+#include "../types/Result.hpp"
+#include "../types/Span.hpp"
+#include "../types/StringView.hpp"
+
+namespace dakt::core {
+
+enum class TranscodeError : std::uint8_t { InvalidInput, OutputTooSmall };
+
+[[nodiscard]] constexpr ErrorCode toErrorCode(TranscodeError e) noexcept {
+  return ErrorCode(ErrorCategory::Transcode, e);
+}
+
+namespace detail::utf {
+
+// Decodes one code point starting at s[i]. Returns the sequence length, or 0
+// for an invalid sequence (overlong, surrogate, > U+10FFFF, truncated).
+inline std::size_t decodeUtf8(const unsigned char *s, std::size_t n,
+                              std::size_t i, char32_t &cp) noexcept {
+  const unsigned char b0 = s[i];
+  if (b0 < 0x80) {
+    cp = b0;
+    return 1;
+  }
+  if (b0 < 0xC2) {
+    return 0;
+  }
+  if (b0 < 0xE0) {
+    if (i + 1 >= n || (s[i + 1] & 0xC0) != 0x80) {
+      return 0;
+    }
+    cp = (char32_t{b0} & 0x1F) << 6 | (s[i + 1] & 0x3F);
+    return 2;
+  }
+  if (b0 < 0xF0) {
+    if (i + 2 >= n || (s[i + 1] & 0xC0) != 0x80 ||
+        (s[i + 2] & 0xC0) != 0x80) {
+      return 0;
+    }
+    cp = (char32_t{b0} & 0x0F) << 12 | (char32_t{s[i + 1]} & 0x3F) << 6 |
+         (s[i + 2] & 0x3F);
+    if (cp < 0x800 || (cp >= 0xD800 && cp <= 0xDFFF)) {
+      return 0;
+    }
+    return 3;
+  }
+  if (b0 < 0xF5) {
+    if (i + 3 >= n || (s[i + 1] & 0xC0) != 0x80 ||
+        (s[i + 2] & 0xC0) != 0x80 || (s[i + 3] & 0xC0) != 0x80) {
+      return 0;
+    }
+    cp = (char32_t{b0} & 0x07) << 18 | (char32_t{s[i + 1]} & 0x3F) << 12 |
+         (char32_t{s[i + 2]} & 0x3F) << 6 | (s[i + 3] & 0x3F);
+    if (cp < 0x10000 || cp > 0x10FFFF) {
+      return 0;
+    }
+    return 4;
+  }
+  return 0;
+}
+
+inline std::size_t encodedUtf8Length(char32_t cp) noexcept {
+  return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+}
+
+inline void encodeUtf8(char32_t cp, char *out) noexcept {
+  if (cp < 0x80) {
+    out[0] = static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    out[0] = static_cast<char>(0xC0 | (cp >> 6));
+    out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+  } else if (cp < 0x10000) {
+    out[0] = static_cast<char>(0xE0 | (cp >> 12));
+    out[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+  } else {
+    out[0] = static_cast<char>(0xF0 | (cp >> 18));
+    out[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+  }
+}
+
+inline bool validateScalar(const unsigned char *s, std::size_t n) noexcept {
+  std::size_t i = 0;
+  while (i < n) {
+    // Skip ASCII eight bytes at a time.
+    if (i + 8 <= n) {
+      std::uint64_t word;
+      std::memcpy(&word, s + i, 8);
+      if ((word & 0x8080808080808080ull) == 0) {
+        i += 8;
+        continue;
+      }
+    }
+    char32_t cp;
+    const std::size_t len = decodeUtf8(s, n, i, cp);
+    if (len == 0) {
+      return false;
+    }
+    i += len;
+  }
+  return true;
+}
+
+#if DAKT_SIMD_X86
+
+// Number of leading ASCII bytes, checked 16 at a time.
+DAKT_TARGET_SSE2 inline std::size_t asciiPrefixSse2(const unsigned char *s,
+                                                    std::size_t n) noexcept {
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      break;
+    }
+  }
+  return i;
+}
+
+// Keiser & Lemire lookup-table validation: every byte is classified by three
+// 16-entry nibble lookups over (previous byte high/low nibble, current byte
+// high nibble); any error class surviving the AND is a violation. 3- and
+// 4-byte sequences are checked by looking two and three bytes back.
+namespace lookup {
+inline constexpr std::uint8_t kTooShort = 1 << 0;
+inline constexpr std::uint8_t kTooLong = 1 << 1;
+inline constexpr std::uint8_t kOverlong3 = 1 << 2;
+inline constexpr std::uint8_t kTooLarge = 1 << 3;
+inline constexpr std::uint8_t kSurrogate = 1 << 4;
+inline constexpr std::uint8_t kOverlong2 = 1 << 5;
+inline constexpr std::uint8_t kTooLarge1000 = 1 << 6;
+inline constexpr std::uint8_t kOverlong4 = 1 << 6;
+inline constexpr std::uint8_t kTwoConts = 1 << 7;
+inline constexpr std::uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+} // namespace lookup
+
+DAKT_TARGET_AVX2 inline __m256i table16(std::uint8_t const (&t)[16]) noexcept {
+  const __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t));
+  return _mm256_broadcastsi128_si256(lane);
+}
+
+// Bytes of `input` shifted right by N positions across the 32-byte boundary,
+// filling in from the tail of `prev`.
+template <int N>
+DAKT_TARGET_AVX2 inline __m256i prevBytes(__m256i input, __m256i prev) noexcept {
+  return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21),
+                            16 - N);
+}
+
+struct Utf8Checker {
+  __m256i error;
+  __m256i prevInput;
+  __m256i prevIncomplete;
+  __m256i byte1High;
+  __m256i byte1Low;
+  __m256i byte2High;
+  __m256i maxValue;
+  __m256i lowNibble;
+};
+
+DAKT_TARGET_AVX2 inline Utf8Checker makeChecker() noexcept {
+  using namespace lookup;
+  static constexpr std::uint8_t kByte1High[16] = {
+      kTooLong,  kTooLong,  kTooLong,  kTooLong,
+      kTooLong,  kTooLong,  kTooLong,  kTooLong,
+      kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+      kTooShort | kOverlong2,
+      kTooShort,
+      kTooShort | kOverlong3 | kSurrogate,
+      kTooShort | kTooLarge | kTooLarge1000 | kOverlong4};
+  static constexpr std::uint8_t kByte1Low[16] = {
+      kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+      kCarry | kOverlong2,
+      kCarry,
+      kCarry,
+      kCarry | kTooLarge,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+      kCarry | kTooLarge | kTooLarge1000,
+      kCarry | kTooLarge | kTooLarge1000};
+  static constexpr std::uint8_t kByte2High[16] = {
+      kTooShort, kTooShort, kTooShort, kTooShort,
+      kTooShort, kTooShort, kTooShort, kTooShort,
+      kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 |
+          kOverlong4,
+      kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+      kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+      kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+      kTooShort, kTooShort, kTooShort, kTooShort};
+  Utf8Checker c;
+  c.error = _mm256_setzero_si256();
+  c.prevInput = _mm256_setzero_si256();
+  c.prevIncomplete = _mm256_setzero_si256();
+  c.byte1High = table16(kByte1High);
+  c.byte1Low = table16(kByte1Low);
+  c.byte2High = table16(kByte2High);
+  // A lead byte in the last 1/2/3 positions that needs more bytes than remain.
+  c.maxValue = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, static_cast<char>(0xF0 - 1),
+      static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+  c.lowNibble = _mm256_set1_epi8(0x0F);
+  return c;
+}
+
+DAKT_TARGET_AVX2 inline void checkBlock(Utf8Checker &c,
+                                        __m256i input) noexcept {
+  if (_mm256_movemask_epi8(input) == 0) {
+    c.error = _mm256_or_si256(c.error, c.prevIncomplete);
+    c.prevIncomplete = _mm256_setzero_si256();
+    c.prevInput = input;
+    return;
+  }
+  const __m256i prev1 = prevBytes<1>(input, c.prevInput);
+  const __m256i b1High = _mm256_shuffle_epi8(
+      c.byte1High, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), c.lowNibble));
+  const __m256i b1Low =
+      _mm256_shuffle_epi8(c.byte1Low, _mm256_and_si256(prev1, c.lowNibble));
+  const __m256i b2High = _mm256_shuffle_epi8(
+      c.byte2High, _mm256_and_si256(_mm256_srli_epi16(input, 4), c.lowNibble));
+  const __m256i special =
+      _mm256_and_si256(_mm256_and_si256(b1High, b1Low), b2High);
+
+  const __m256i prev2 = prevBytes<2>(input, c.prevInput);
+  const __m256i prev3 = prevBytes<3>(input, c.prevInput);
+  const __m256i is3 = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80));
+  const __m256i is4 = _mm256_subs_epu8(
+      prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+  const __m256i must23 = _mm256_and_si256(_mm256_or_si256(is3, is4),
+                                          _mm256_set1_epi8(static_cast<char>(0x80)));
+  c.error = _mm256_or_si256(c.error, _mm256_xor_si256(must23, special));
+  c.prevIncomplete = _mm256_subs_epu8(input, c.maxValue);
+  c.prevInput = input;
+}
+
+DAKT_TARGET_AVX2 inline bool validateAvx2(const unsigned char *s,
+                                          std::size_t n) noexcept {
+  Utf8Checker c = makeChecker();
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    checkBlock(c,
+               _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + i)));
+  }
+  if (i < n) {
+    alignas(32) unsigned char tail[32]{};
+    std::memcpy(tail, s + i, n - i);
+    checkBlock(c, _mm256_load_si256(reinterpret_cast<const __m256i *>(tail)));
+  }
+  c.error = _mm256_or_si256(c.error, c.prevIncomplete);
+  return _mm256_testz_si256(c.error, c.error) != 0;
+}
+
+// Widening ASCII copies used by the transcoders; return bytes consumed.
+DAKT_TARGET_AVX2 inline std::size_t
+asciiToUtf16Avx2(const unsigned char *s, std::size_t n, char16_t *out,
+                 std::size_t outCap) noexcept {
+  std::size_t i = 0;
+  for (; i + 16 <= n && i + 16 <= outCap; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm256_cvtepu8_epi16(v));
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t
+asciiToUtf32Avx2(const unsigned char *s, std::size_t n, char32_t *out,
+                 std::size_t outCap) noexcept {
+  std::size_t i = 0;
+  for (; i + 16 <= n && i + 16 <= outCap; i += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+    if (_mm_movemask_epi8(v) != 0) {
+      break;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm256_cvtepu8_epi32(v));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 8),
+                        _mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)));
+  }
+  return i;
+}
+
+#endif // DAKT_SIMD_X86
+
+inline const unsigned char *bytes(StringView s) noexcept {
+  return reinterpret_cast<const unsigned char *>(s.data());
+}
+
+} // namespace detail::utf
+
+[[nodiscard]] inline bool isValidUtf8(StringView text) noexcept {
+  const unsigned char *s = detail::utf::bytes(text);
+  const std::size_t n = text.size();
+#if DAKT_SIMD_X86
+  switch (simdLevel()) {
+  case SimdLevel::AVX2:
+    return detail::utf::validateAvx2(s, n);
+  case SimdLevel::SSE2: {
+    const std::size_t skip = detail::utf::asciiPrefixSse2(s, n);
+    return detail::utf::validateScalar(s + skip, n - skip);
+  }
+  case SimdLevel::Scalar:
+    break;
+  }
+#endif
+  return detail::utf::validateScalar(s, n);
+}
+
+// Transcoders write into caller-provided buffers and return the number of
+// code units written. Invalid input (including unpaired surrogates) fails the
+// whole call; the output buffer contents are then unspecified.
+
+[[nodiscard]] inline Result<std::size_t, TranscodeError>
+utf8ToUtf16(StringView text, Span<char16_t> out) noexcept {
+  using R = Result<std::size_t, TranscodeError>;
+  const unsigned char *s = detail::utf::bytes(text);
+  const std::size_t n = text.size();
+  std::size_t i = 0;
+  std::size_t o = 0;
+  while (i < n) {
+#if DAKT_SIMD_X86
+    if (s[i] < 0x80 && simdLevel() == SimdLevel::AVX2) {
+      const std::size_t k = detail::utf::asciiToUtf16Avx2(
+          s + i, n - i, out.data() + o, out.size() - o);
+      i += k;
+      o += k;
+      if (i == n) {
+        break;
+      }
+    }
+#endif
+    char32_t cp;
+    const std::size_t len = detail::utf::decodeUtf8(s, n, i, cp);
+    if (len == 0) {
+      return R::err(TranscodeError::InvalidInput);
+    }
+    const std::size_t units = cp >= 0x10000 ? 2 : 1;
+    if (o + units > out.size()) {
+      return R::err(TranscodeError::OutputTooSmall);
+    }
+    if (units == 2) {
+      cp -= 0x10000;
+      out[o++] = static_cast<char16_t>(0xD800 + (cp >> 10));
+      out[o++] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+    } else {
+      out[o++] = static_cast<char16_t>(cp);
+    }
+    i += len;
+  }
+  return R::ok(o);
+}
+
+[[nodiscard]] inline Result<std::size_t, TranscodeError>
+utf8ToUtf32(StringView text, Span<char32_t> out) noexcept {
+  using R = Result<std::size_t, TranscodeError>;
+  const unsigned char *s = detail::utf::bytes(text);
+  const std::size_t n = text.size();
+  std::size_t i = 0;
+  std::size_t o = 0;
+  while (i < n) {
+#if DAKT_SIMD_X86
+    if (s[i] < 0x80 && simdLevel() == SimdLevel::AVX2) {
+      const std::size_t k = detail::utf::asciiToUtf32Avx2(
+          s + i, n - i, out.data() + o, out.size() - o);
+      i += k;
+      o += k;
+      if (i == n) {
+        break;
+      }
+    }
+#endif
+    char32_t cp;
+    const std::size_t len = detail::utf::decodeUtf8(s, n, i, cp);
+    if (len == 0) {
+      return R::err(TranscodeError::InvalidInput);
+    }
+    if (o == out.size()) {
+      return R::err(TranscodeError::OutputTooSmall);
+    }
+    out[o++] = cp;
+    i += len;
+  }
+  return R::ok(o);
+}
+
+[[nodiscard]] inline Result<std::size_t, TranscodeError>
+utf16ToUtf8(Span<const char16_t> text, Span<char> out) noexcept {
+  using R = Result<std::size_t, TranscodeError>;
+  std::size_t o = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    char32_t cp = text[i];
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+      if (cp >= 0xDC00 || i + 1 == text.size() || text[i + 1] < 0xDC00 ||
+          text[i + 1] > 0xDFFF) {
+        return R::err(TranscodeError::InvalidInput);
+      }
+      cp = 0x10000 + ((cp - 0xD800) << 10) + (text[++i] - 0xDC00);
+    }
+    const std::size_t len = detail::utf::encodedUtf8Length(cp);
+    if (o + len > out.size()) {
+      return R::err(TranscodeError::OutputTooSmall);
+    }
+    detail::utf::encodeUtf8(cp, out.data() + o);
+    o += len;
+  }
+  return R::ok(o);
+}
+
+[[nodiscard]] inline Result<std::size_t, TranscodeError>
+utf32ToUtf8(Span<const char32_t> text, Span<char> out) noexcept {
+  using R = Result<std::size_t, TranscodeError>;
+  std::size_t o = 0;
+  for (const char32_t cp : text) {
+    if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+      return R::err(TranscodeError::InvalidInput);
+    }
+    const std::size_t len = detail::utf::encodedUtf8Length(cp);
+    if (o + len > out.size()) {
+      return R::err(TranscodeError::OutputTooSmall);
+    }
+    detail::utf::encodeUtf8(cp, out.data() + o);
+    o += len;
+  }
+  return R::ok(o);
+}
+
+// Output sizes for valid input, for sizing buffers before transcoding.
+[[nodiscard]] inline std::size_t utf16LengthOf(StringView text) noexcept {
+  std::size_t units = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    const auto b = static_cast<unsigned char>(text[i]);
+    units += (b & 0xC0) != 0x80;
+    units += b >= 0xF0;
+  }
+  return units;
+}
+
+[[nodiscard]] inline std::size_t utf32LengthOf(StringView text) noexcept {
+  std::size_t cps = 0;
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    cps += (static_cast<unsigned char>(text[i]) & 0xC0) != 0x80;
+  }
+  return cps;
+}
+
+} // namespace dakt::core
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "StringView.hpp"
+#include "Symbol.hpp"
+
+namespace dakt::core {
+
+// Broad origin of an error. Values up to 0x7FFF are usable; applications
+// should allocate theirs from User upwards.
+enum class ErrorCategory : std::uint16_t {
+  None = 0,
+  Generic,
+  Io,
+  Parse,
+  Number,
+  Transcode,
+  Region,
+  Task,
+  Platform,
+  User = 0x4000,
+};
+
+[[nodiscard]] constexpr StringView categoryName(ErrorCategory c) noexcept {
+  switch (c) {
+  case ErrorCategory::None:
+    return StringView("none", 4);
+  case ErrorCategory::Generic:
+    return StringView("generic", 7);
+  case ErrorCategory::Io:
+    return StringView("io", 2);
+  case ErrorCategory::Parse:
+    return StringView("parse", 5);
+  case ErrorCategory::Number:
+    return StringView("number", 6);
+  case ErrorCategory::Transcode:
+    return StringView("transcode", 9);
+  case ErrorCategory::Region:
+    return StringView("region", 6);
+  case ErrorCategory::Task:
+    return StringView("task", 4);
+  case ErrorCategory::Platform:
+    return StringView("platform", 8);
+  case ErrorCategory::User:
+    break;
+  }
+  return c >= ErrorCategory::User ? StringView("user", 4)
+                                  : StringView("unknown", 7);
+}
+
+// Allocation-free error value that fits in one register: a category, a
+// category-specific code and a 32-bit detail, which is either a plain payload
+// (a line number, an offset) or the Symbol of a message in a StringInterner.
+//
+// Only the low 63 bits are ever used, which leaves a spare bit for Result to
+// tell an error apart from a value without a separate tag.
+class ErrorCode {
+public:
+  static constexpr std::uint16_t kMaxCategory = 0x7FFF;
+
+  constexpr ErrorCode() noexcept = default;
+  constexpr ErrorCode(ErrorCategory category, std::uint16_t code,
+                      std::uint32_t detail = 0) noexcept
+      : bits_((std::uint64_t{static_cast<std::uint16_t>(category)} &
+               kMaxCategory) << 48 |
+              std::uint64_t{code} << 32 | detail) {}
+
+  template <typename Enum>
+    requires std::is_enum_v<Enum>
+  constexpr ErrorCode(ErrorCategory category, Enum code,
+                      std::uint32_t detail = 0) noexcept
+      : ErrorCode(category, static_cast<std::uint16_t>(code), detail) {}
+
+  [[nodiscard]] constexpr ErrorCategory category() const noexcept {
+    return static_cast<ErrorCategory>(bits_ >> 48);
+  }
+  [[nodiscard]] constexpr std::uint16_t code() const noexcept {
+    return static_cast<std::uint16_t>(bits_ >> 32);
+  }
+  [[nodiscard]] constexpr std::uint32_t detail() const noexcept {
+    return static_cast<std::uint32_t>(bits_);
+  }
+  [[nodiscard]] constexpr Symbol message() const noexcept {
+    return Symbol{detail()};
+  }
+
+  [[nodiscard]] constexpr ErrorCode
+  withDetail(std::uint32_t detail) const noexcept {
+    return fromBits((bits_ & ~std::uint64_t{0xFFFFFFFFu}) | detail);
+  }
+  [[nodiscard]] constexpr ErrorCode withMessage(Symbol message) const noexcept {
+    return withDetail(message.value);
+  }
+
+  // True when category and code match, whatever the detail.
+  [[nodiscard]] constexpr bool is(ErrorCategory category,
+                                  std::uint16_t code) const noexcept {
+    return (bits_ >> 32) ==
+           ((std::uint64_t{static_cast<std::uint16_t>(category)} << 16) | code);
+  }
+
+  [[nodiscard]] constexpr std::uint64_t bits() const noexcept { return bits_; }
+  [[nodiscard]] static constexpr ErrorCode
+  fromBits(std::uint64_t bits) noexcept {
+    ErrorCode e;
+    e.bits_ = bits & kPayloadMask;
+    return e;
+  }
+
+  constexpr bool operator==(const ErrorCode &) const noexcept = default;
+
+private:
+  static constexpr std::uint64_t kPayloadMask = ~(std::uint64_t{1} << 63);
+
+  std::uint64_t bits_{0};
+};
+
+static_assert(sizeof(ErrorCode) == sizeof(std::uint64_t));
+static_assert(std::is_trivially_copyable_v<ErrorCode>);
+
+} // namespace dakt::core
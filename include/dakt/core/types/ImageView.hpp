@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#include "Rect.hpp"
+#include "Span.hpp"
+
+namespace dakt::core {
+
+// Non-owning view over a 2D pixel buffer. Rows are `width` elements long and
+// `strideBytes` apart, so padded rows and sub-rectangles of a larger image are
+// represented without copying. Inner loops over row(y) are plain contiguous
+// spans and vectorize like any other array loop.
+template <typename T> class ImageView {
+  using Byte = std::conditional_t<std::is_const_v<T>, const std::byte,
+                                  std::byte>;
+
+public:
+  using element_type = T;
+
+  class RowIterator {
+  public:
+    using value_type = Span<T>;
+    using difference_type = std::ptrdiff_t;
+
+    RowIterator() noexcept = default;
+    RowIterator(Byte *row, std::size_t width, std::size_t stride) noexcept
+        : row_(row), width_(width), stride_(stride) {}
+
+    [[nodiscard]] Span<T> operator*() const noexcept {
+      return Span<T>(reinterpret_cast<T *>(row_), width_);
+    }
+    RowIterator &operator++() noexcept {
+      row_ += stride_;
+      return *this;
+    }
+    RowIterator operator++(int) noexcept {
+      RowIterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    [[nodiscard]] bool operator==(const RowIterator &other) const noexcept {
+      return row_ == other.row_;
+    }
+
+  private:
+    Byte *row_{nullptr};
+    std::size_t width_{0};
+    std::size_t stride_{0};
+  };
+
+  class RowRange {
+  public:
+    RowRange(RowIterator first, RowIterator last) noexcept
+        : first_(first), last_(last) {}
+    [[nodiscard]] RowIterator begin() const noexcept { return first_; }
+    [[nodiscard]] RowIterator end() const noexcept { return last_; }
+
+  private:
+    RowIterator first_;
+    RowIterator last_;
+  };
+
+  constexpr ImageView() noexcept = default;
+
+  constexpr ImageView(T *data, std::size_t width, std::size_t height,
+                      std::size_t strideBytes) noexcept
+      : data_(data), width_(width), height_(height), stride_(strideBytes) {}
+
+  // Tightly packed rows.
+  constexpr ImageView(T *data, std::size_t width, std::size_t height) noexcept
+      : ImageView(data, width, height, width * sizeof(T)) {}
+
+  template <typename U>
+    requires(std::is_const_v<T> && std::is_same_v<const U, T>)
+  constexpr ImageView(const ImageView<U> &other) noexcept
+      : data_(other.data()), width_(other.width()), height_(other.height()),
+        stride_(other.strideBytes()) {}
+
+  [[nodiscard]] constexpr T *data() const noexcept { return data_; }
+  [[nodiscard]] constexpr std::size_t width() const noexcept { return width_; }
+  [[nodiscard]] constexpr std::size_t height() const noexcept {
+    return height_;
+  }
+  [[nodiscard]] constexpr std::size_t strideBytes() const noexcept {
+    return stride_;
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return width_ == 0 || height_ == 0;
+  }
+  [[nodiscard]] constexpr bool isContiguous() const noexcept {
+    return stride_ == width_ * sizeof(T);
+  }
+  [[nodiscard]] constexpr Rect bounds() const noexcept {
+    return Rect{0, 0, static_cast<int>(width_), static_cast<int>(height_)};
+  }
+
+  [[nodiscard]] T *rowPtr(std::size_t y) const noexcept {
+    return reinterpret_cast<T *>(reinterpret_cast<Byte *>(data_) +
+                                 y * stride_);
+  }
+
+  [[nodiscard]] Span<T> row(std::size_t y) const noexcept {
+    return Span<T>(rowPtr(y), width_);
+  }
+
+  [[nodiscard]] T &operator()(std::size_t x, std::size_t y) const noexcept {
+    return rowPtr(y)[x];
+  }
+
+  [[nodiscard]] RowRange rows() const noexcept {
+    auto *first = reinterpret_cast<Byte *>(data_);
+    return RowRange(RowIterator(first, width_, stride_),
+                    RowIterator(first + height_ * stride_, width_, stride_));
+  }
+
+  // View of `r` clipped to this image. Shares the parent's stride.
+  [[nodiscard]] ImageView subview(const Rect &r) const noexcept {
+    const Rect c = intersect(r, bounds());
+    if (c.empty()) {
+      return ImageView();
+    }
+    return ImageView(rowPtr(static_cast<std::size_t>(c.y)) + c.x,
+                     static_cast<std::size_t>(c.width),
+                     static_cast<std::size_t>(c.height), stride_);
+  }
+
+  // The whole view as one span; only meaningful when isContiguous().
+  [[nodiscard]] Span<T> pixels() const noexcept {
+    return Span<T>(data_, width_ * height_);
+  }
+
+private:
+  T *data_{nullptr};
+  std::size_t width_{0};
+  std::size_t height_{0};
+  std::size_t stride_{0};
+};
+
+template <typename T> using Span2D = ImageView<T>;
+
+// Copies min(src, dst) sized overlap row by row; one memcpy when both views
+// are contiguous.
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+void copyPixels(std::type_identity_t<ImageView<const T>> src,
+                ImageView<T> dst) noexcept {
+  const std::size_t w = std::min(src.width(), dst.width());
+  const std::size_t h = std::min(src.height(), dst.height());
+  if (w == 0 || h == 0) {
+    return;
+  }
+  if (src.isContiguous() && dst.isContiguous() && w == src.width() &&
+      w == dst.width()) {
+    std::memcpy(dst.data(), src.data(), w * h * sizeof(T));
+    return;
+  }
+  for (std::size_t y = 0; y < h; ++y) {
+    std::memcpy(dst.rowPtr(y), src.rowPtr(y), w * sizeof(T));
+  }
+}
+
+} // namespace dakt::core
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace dakt::core {
+
+struct Rect {
+  int x{};
+  int y{};
+  int width{};
+  int height{};
+
+  [[nodiscard]] constexpr int right() const noexcept { return x + width; }
+  [[nodiscard]] constexpr int bottom() const noexcept { return y + height; }
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return width <= 0 || height <= 0;
+  }
+  [[nodiscard]] constexpr std::int64_t area() const noexcept {
+    return empty() ? 0
+                   : static_cast<std::int64_t>(width) *
+                         static_cast<std::int64_t>(height);
+  }
+
+  [[nodiscard]] constexpr bool contains(int px, int py) const noexcept {
+    return px >= x && px < right() && py >= y && py < bottom();
+  }
+
+  [[nodiscard]] constexpr bool operator==(const Rect &) const noexcept =
+      default;
+};
+
+// Overlapping area of two rects. A disjoint pair yields an empty rect anchored
+// at the would-be top-left corner so batch kernels can produce it branch-free.
+[[nodiscard]] constexpr Rect intersect(const Rect &a, const Rect &b) noexcept {
+  const int x1 = std::max(a.x, b.x);
+  const int y1 = std::max(a.y, b.y);
+  const int w = std::min(a.right(), b.right()) - x1;
+  const int h = std::min(a.bottom(), b.bottom()) - y1;
+  if (w <= 0 || h <= 0) {
+    return Rect{x1, y1, 0, 0};
+  }
+  return Rect{x1, y1, w, h};
+}
+
+// Smallest rect covering both inputs; empty inputs are ignored.
+[[nodiscard]] constexpr Rect unite(const Rect &a, const Rect &b) noexcept {
+  if (a.empty()) {
+    return b.empty() ? Rect{} : b;
+  }
+  if (b.empty()) {
+    return a;
+  }
+  const int x1 = std::min(a.x, b.x);
+  const int y1 = std::min(a.y, b.y);
+  return Rect{x1, y1, std::max(a.right(), b.right()) - x1,
+              std::max(a.bottom(), b.bottom()) - y1};
+}
+
+[[nodiscard]] constexpr Rect translate(const Rect &r, int dx, int dy) noexcept {
+  return Rect{r.x + dx, r.y + dy, r.width, r.height};
+}
+
+} // namespace dakt::core
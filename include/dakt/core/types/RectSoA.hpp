@@ -0,0 +1,700 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include "../interfaces/IAllocator.hpp"
+#include "../platform/Simd.hpp"
+#include "Rect.hpp"
+#include "Span.hpp"
+
+namespace dakt::core {
+
+namespace detail::rectsoa {
+
+struct Columns {
+  int *x;
+  int *y;
+  int *w;
+  int *h;
+};
+
+struct ConstColumns {
+  const int *x;
+  const int *y;
+  const int *w;
+  const int *h;
+};
+
+// Scalar kernels. These define the reference semantics and handle the tails
+// left over by the vector loops.
+
+inline void intersectScalar(ConstColumns in, Columns out, std::size_t begin,
+                            std::size_t end, const Rect &clip) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    const Rect r = intersect(Rect{in.x[i], in.y[i], in.w[i], in.h[i]}, clip);
+    out.x[i] = r.x;
+    out.y[i] = r.y;
+    out.w[i] = r.width;
+    out.h[i] = r.height;
+  }
+}
+
+inline void containsScalar(ConstColumns in, std::size_t begin,
+                           std::size_t end, int px, int py,
+                           std::uint64_t *mask) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    if (Rect{in.x[i], in.y[i], in.w[i], in.h[i]}.contains(px, py)) {
+      mask[i / 64] |= std::uint64_t{1} << (i % 64);
+    }
+  }
+}
+
+inline void areasScalar(ConstColumns in, std::size_t begin, std::size_t end,
+                        std::int64_t *out) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    out[i] = Rect{in.x[i], in.y[i], in.w[i], in.h[i]}.area();
+  }
+}
+
+struct Extent {
+  int minX{INT_MAX};
+  int minY{INT_MAX};
+  int maxX{INT_MIN};
+  int maxY{INT_MIN};
+
+  [[nodiscard]] Rect toRect() const noexcept {
+    if (minX > maxX) {
+      return Rect{};
+    }
+    return Rect{minX, minY, maxX - minX, maxY - minY};
+  }
+};
+
+inline void boundsScalar(ConstColumns in, std::size_t begin, std::size_t end,
+                         Extent &ext) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    if (in.w[i] <= 0 || in.h[i] <= 0) {
+      continue;
+    }
+    ext.minX = std::min(ext.minX, in.x[i]);
+    ext.minY = std::min(ext.minY, in.y[i]);
+    ext.maxX = std::max(ext.maxX, in.x[i] + in.w[i]);
+    ext.maxY = std::max(ext.maxY, in.y[i] + in.h[i]);
+  }
+}
+
+inline void translateScalar(Columns io, std::size_t begin, std::size_t end,
+                            int dx, int dy) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    io.x[i] += dx;
+    io.y[i] += dy;
+  }
+}
+
+inline int scaleOne(int v, float s) noexcept {
+  return static_cast<int>(std::nearbyint(static_cast<float>(v) * s));
+}
+
+inline void scaleScalar(Columns io, std::size_t begin, std::size_t end,
+                        float sx, float sy) noexcept {
+  for (std::size_t i = begin; i < end; ++i) {
+    io.x[i] = scaleOne(io.x[i], sx);
+    io.y[i] = scaleOne(io.y[i], sy);
+    io.w[i] = scaleOne(io.w[i], sx);
+    io.h[i] = scaleOne(io.h[i], sy);
+  }
+}
+
+#if DAKT_SIMD_X86
+
+DAKT_TARGET_SSE2 inline __m128i load128(const int *p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+DAKT_TARGET_AVX2 inline __m256i load256(const int *p) noexcept {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+// SSE2 has no packed 32-bit min/max, so they are built from compare + select.
+DAKT_TARGET_SSE2 inline __m128i select128(__m128i m, __m128i a,
+                                          __m128i b) noexcept {
+  return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+DAKT_TARGET_SSE2 inline __m128i min128(__m128i a, __m128i b) noexcept {
+  return select128(_mm_cmpgt_epi32(a, b), b, a);
+}
+DAKT_TARGET_SSE2 inline __m128i max128(__m128i a, __m128i b) noexcept {
+  return select128(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+DAKT_TARGET_SSE2 inline std::size_t
+intersectSse2(ConstColumns in, Columns out, std::size_t n,
+              const Rect &clip) noexcept {
+  const __m128i cx = _mm_set1_epi32(clip.x);
+  const __m128i cy = _mm_set1_epi32(clip.y);
+  const __m128i cr = _mm_set1_epi32(clip.right());
+  const __m128i cb = _mm_set1_epi32(clip.bottom());
+  const __m128i zero = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i x = load128(in.x + i);
+    const __m128i y = load128(in.y + i);
+    const __m128i w = load128(in.w + i);
+    const __m128i h = load128(in.h + i);
+    const __m128i x1 = max128(x, cx);
+    const __m128i y1 = max128(y, cy);
+    __m128i nw = _mm_sub_epi32(min128(_mm_add_epi32(x, w), cr), x1);
+    __m128i nh = _mm_sub_epi32(min128(_mm_add_epi32(y, h), cb), y1);
+    const __m128i valid =
+        _mm_and_si128(_mm_cmpgt_epi32(nw, zero), _mm_cmpgt_epi32(nh, zero));
+    nw = _mm_and_si128(nw, valid);
+    nh = _mm_and_si128(nh, valid);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out.x + i), x1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out.y + i), y1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out.w + i), nw);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out.h + i), nh);
+  }
+  return i;
+}
+
+DAKT_TARGET_SSE2 inline std::size_t
+containsSse2(ConstColumns in, std::size_t n, int px, int py,
+             std::uint64_t *mask) noexcept {
+  const __m128i p = _mm_set1_epi32(px);
+  const __m128i q = _mm_set1_epi32(py);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i x = load128(in.x + i);
+    const __m128i y = load128(in.y + i);
+    const __m128i w = load128(in.w + i);
+    const __m128i h = load128(in.h + i);
+    const __m128i inX = _mm_andnot_si128(
+        _mm_cmpgt_epi32(x, p), _mm_cmpgt_epi32(_mm_add_epi32(x, w), p));
+    const __m128i inY = _mm_andnot_si128(
+        _mm_cmpgt_epi32(y, q), _mm_cmpgt_epi32(_mm_add_epi32(y, h), q));
+    const auto bits = static_cast<std::uint64_t>(
+        _mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(inX, inY))));
+    mask[i / 64] |= bits << (i % 64);
+  }
+  return i;
+}
+
+DAKT_TARGET_SSE2 inline std::size_t areasSse2(ConstColumns in, std::size_t n,
+                                              std::int64_t *out) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i w = load128(in.w + i);
+    __m128i h = load128(in.h + i);
+    const __m128i valid =
+        _mm_and_si128(_mm_cmpgt_epi32(w, zero), _mm_cmpgt_epi32(h, zero));
+    w = _mm_and_si128(w, valid);
+    h = _mm_and_si128(h, valid);
+    // Both factors are non-negative here, so the unsigned multiply is exact.
+    const __m128i even = _mm_mul_epu32(w, h);
+    const __m128i odd =
+        _mm_mul_epu32(_mm_srli_epi64(w, 32), _mm_srli_epi64(h, 32));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm_unpacklo_epi64(even, odd));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i + 2),
+                     _mm_unpackhi_epi64(even, odd));
+  }
+  return i;
+}
+
+DAKT_TARGET_SSE2 inline std::size_t boundsSse2(ConstColumns in, std::size_t n,
+                                               Extent &ext) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i hi = _mm_set1_epi32(INT_MAX);
+  const __m128i lo = _mm_set1_epi32(INT_MIN);
+  __m128i minX = hi;
+  __m128i minY = hi;
+  __m128i maxX = lo;
+  __m128i maxY = lo;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i x = load128(in.x + i);
+    const __m128i y = load128(in.y + i);
+    const __m128i w = load128(in.w + i);
+    const __m128i h = load128(in.h + i);
+    const __m128i valid =
+        _mm_and_si128(_mm_cmpgt_epi32(w, zero), _mm_cmpgt_epi32(h, zero));
+    minX = min128(minX, select128(valid, x, hi));
+    minY = min128(minY, select128(valid, y, hi));
+    maxX = max128(maxX, select128(valid, _mm_add_epi32(x, w), lo));
+    maxY = max128(maxY, select128(valid, _mm_add_epi32(y, h), lo));
+  }
+  alignas(16) int lanes[4][4];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes[0]), minX);
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes[1]), minY);
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes[2]), maxX);
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes[3]), maxY);
+  for (int k = 0; k < 4; ++k) {
+    ext.minX = std::min(ext.minX, lanes[0][k]);
+    ext.minY = std::min(ext.minY, lanes[1][k]);
+    ext.maxX = std::max(ext.maxX, lanes[2][k]);
+    ext.maxY = std::max(ext.maxY, lanes[3][k]);
+  }
+  return i;
+}
+
+DAKT_TARGET_SSE2 inline std::size_t translateSse2(Columns io, std::size_t n,
+                                                  int dx, int dy) noexcept {
+  const __m128i vx = _mm_set1_epi32(dx);
+  const __m128i vy = _mm_set1_epi32(dy);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    auto *px = reinterpret_cast<__m128i *>(io.x + i);
+    auto *py = reinterpret_cast<__m128i *>(io.y + i);
+    _mm_storeu_si128(px, _mm_add_epi32(_mm_loadu_si128(px), vx));
+    _mm_storeu_si128(py, _mm_add_epi32(_mm_loadu_si128(py), vy));
+  }
+  return i;
+}
+
+DAKT_TARGET_SSE2 inline void scaleColumnSse2(int *col, std::size_t n,
+                                             float s) noexcept {
+  const __m128 vs = _mm_set1_ps(s);
+  for (std::size_t i = 0; i + 4 <= n; i += 4) {
+    auto *p = reinterpret_cast<__m128i *>(col + i);
+    const __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(p)), vs);
+    _mm_storeu_si128(p, _mm_cvtps_epi32(f));
+  }
+}
+
+DAKT_TARGET_SSE2 inline std::size_t scaleSse2(Columns io, std::size_t n,
+                                              float sx, float sy) noexcept {
+  scaleColumnSse2(io.x, n, sx);
+  scaleColumnSse2(io.y, n, sy);
+  scaleColumnSse2(io.w, n, sx);
+  scaleColumnSse2(io.h, n, sy);
+  return n & ~std::size_t{3};
+}
+
+DAKT_TARGET_AVX2 inline std::size_t
+intersectAvx2(ConstColumns in, Columns out, std::size_t n,
+              const Rect &clip) noexcept {
+  const __m256i cx = _mm256_set1_epi32(clip.x);
+  const __m256i cy = _mm256_set1_epi32(clip.y);
+  const __m256i cr = _mm256_set1_epi32(clip.right());
+  const __m256i cb = _mm256_set1_epi32(clip.bottom());
+  const __m256i zero = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i x = load256(in.x + i);
+    const __m256i y = load256(in.y + i);
+    const __m256i w = load256(in.w + i);
+    const __m256i h = load256(in.h + i);
+    const __m256i x1 = _mm256_max_epi32(x, cx);
+    const __m256i y1 = _mm256_max_epi32(y, cy);
+    __m256i nw =
+        _mm256_sub_epi32(_mm256_min_epi32(_mm256_add_epi32(x, w), cr), x1);
+    __m256i nh =
+        _mm256_sub_epi32(_mm256_min_epi32(_mm256_add_epi32(y, h), cb), y1);
+    const __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(nw, zero),
+                                           _mm256_cmpgt_epi32(nh, zero));
+    nw = _mm256_and_si256(nw, valid);
+    nh = _mm256_and_si256(nh, valid);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.x + i), x1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.y + i), y1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.w + i), nw);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.h + i), nh);
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t
+containsAvx2(ConstColumns in, std::size_t n, int px, int py,
+             std::uint64_t *mask) noexcept {
+  const __m256i p = _mm256_set1_epi32(px);
+  const __m256i q = _mm256_set1_epi32(py);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i x = load256(in.x + i);
+    const __m256i y = load256(in.y + i);
+    const __m256i w = load256(in.w + i);
+    const __m256i h = load256(in.h + i);
+    const __m256i inX =
+        _mm256_andnot_si256(_mm256_cmpgt_epi32(x, p),
+                            _mm256_cmpgt_epi32(_mm256_add_epi32(x, w), p));
+    const __m256i inY =
+        _mm256_andnot_si256(_mm256_cmpgt_epi32(y, q),
+                            _mm256_cmpgt_epi32(_mm256_add_epi32(y, h), q));
+    const auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_and_si256(inX, inY))));
+    mask[i / 64] |= bits << (i % 64);
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t areasAvx2(ConstColumns in, std::size_t n,
+                                              std::int64_t *out) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i w = load256(in.w + i);
+    __m256i h = load256(in.h + i);
+    const __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(w, zero),
+                                           _mm256_cmpgt_epi32(h, zero));
+    w = _mm256_and_si256(w, valid);
+    h = _mm256_and_si256(h, valid);
+    const __m256i wLo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(w));
+    const __m256i hLo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(h));
+    const __m256i wHi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(w, 1));
+    const __m256i hHi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(h, 1));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm256_mul_epi32(wLo, hLo));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 4),
+                        _mm256_mul_epi32(wHi, hHi));
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t boundsAvx2(ConstColumns in, std::size_t n,
+                                               Extent &ext) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i hi = _mm256_set1_epi32(INT_MAX);
+  const __m256i lo = _mm256_set1_epi32(INT_MIN);
+  __m256i minX = hi;
+  __m256i minY = hi;
+  __m256i maxX = lo;
+  __m256i maxY = lo;
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const __m256i x = load256(in.x + i);
+    const __m256i y = load256(in.y + i);
+    const __m256i w = load256(in.w + i);
+    const __m256i h = load256(in.h + i);
+    const __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(w, zero),
+                                           _mm256_cmpgt_epi32(h, zero));
+    minX = _mm256_min_epi32(minX, _mm256_blendv_epi8(hi, x, valid));
+    minY = _mm256_min_epi32(minY, _mm256_blendv_epi8(hi, y, valid));
+    maxX = _mm256_max_epi32(
+        maxX, _mm256_blendv_epi8(lo, _mm256_add_epi32(x, w), valid));
+    maxY = _mm256_max_epi32(
+        maxY, _mm256_blendv_epi8(lo, _mm256_add_epi32(y, h), valid));
+  }
+  alignas(32) int lanes[4][8];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[0]), minX);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[1]), minY);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[2]), maxX);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes[3]), maxY);
+  for (int k = 0; k < 8; ++k) {
+    ext.minX = std::min(ext.minX, lanes[0][k]);
+    ext.minY = std::min(ext.minY, lanes[1][k]);
+    ext.maxX = std::max(ext.maxX, lanes[2][k]);
+    ext.maxY = std::max(ext.maxY, lanes[3][k]);
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline std::size_t translateAvx2(Columns io, std::size_t n,
+                                                  int dx, int dy) noexcept {
+  const __m256i vx = _mm256_set1_epi32(dx);
+  const __m256i vy = _mm256_set1_epi32(dy);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    auto *px = reinterpret_cast<__m256i *>(io.x + i);
+    auto *py = reinterpret_cast<__m256i *>(io.y + i);
+    _mm256_storeu_si256(px, _mm256_add_epi32(_mm256_loadu_si256(px), vx));
+    _mm256_storeu_si256(py, _mm256_add_epi32(_mm256_loadu_si256(py), vy));
+  }
+  return i;
+}
+
+DAKT_TARGET_AVX2 inline void scaleColumnAvx2(int *col, std::size_t n,
+                                             float s) noexcept {
+  const __m256 vs = _mm256_set1_ps(s);
+  for (std::size_t i = 0; i + 8 <= n; i += 8) {
+    auto *p = reinterpret_cast<__m256i *>(col + i);
+    const __m256 f =
+        _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(p)), vs);
+    _mm256_storeu_si256(p, _mm256_cvtps_epi32(f));
+  }
+}
+
+DAKT_TARGET_AVX2 inline std::size_t scaleAvx2(Columns io, std::size_t n,
+                                              float sx, float sy) noexcept {
+  scaleColumnAvx2(io.x, n, sx);
+  scaleColumnAvx2(io.y, n, sy);
+  scaleColumnAvx2(io.w, n, sx);
+  scaleColumnAvx2(io.h, n, sy);
+  return n & ~std::size_t{7};
+}
+
+#endif // DAKT_SIMD_X86
+
+} // namespace detail::rectsoa
+
+// Structure-of-arrays rect storage for batch geometry. Each column is a
+// contiguous, 32-byte aligned int array so the kernels below run on full
+// vector registers; the widest supported instruction set is picked at run time
+// and a scalar path covers everything else.
+class RectSoA {
+public:
+  explicit RectSoA(IAllocator &allocator) noexcept : allocator_(&allocator) {}
+  RectSoA(IAllocator &allocator, std::size_t capacity)
+      : allocator_(&allocator) {
+    reserve(capacity);
+  }
+
+  RectSoA(const RectSoA &) = delete;
+  RectSoA &operator=(const RectSoA &) = delete;
+
+  RectSoA(RectSoA &&other) noexcept
+      : allocator_(other.allocator_),
+        block_(std::exchange(other.block_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)) {}
+
+  RectSoA &operator=(RectSoA &&other) noexcept {
+    if (this != &other) {
+      release();
+      allocator_ = other.allocator_;
+      block_ = std::exchange(other.block_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      capacity_ = std::exchange(other.capacity_, 0);
+    }
+    return *this;
+  }
+
+  ~RectSoA() { release(); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+  [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+  void clear() noexcept { size_ = 0; }
+
+  void reserve(std::size_t capacity) {
+    if (capacity <= capacity_) {
+      return;
+    }
+    const std::size_t rounded = (capacity + kLanes - 1) & ~(kLanes - 1);
+    auto *block = static_cast<int *>(
+        allocator_->allocate(rounded * 4 * sizeof(int), kAlignment));
+    for (std::size_t c = 0; c < 4 && size_ != 0; ++c) {
+      std::memcpy(block + c * rounded, block_ + c * capacity_,
+                  size_ * sizeof(int));
+    }
+    release();
+    block_ = block;
+    capacity_ = rounded;
+  }
+
+  void resize(std::size_t size) {
+    reserve(size);
+    for (std::size_t i = size_; i < size; ++i) {
+      set(i, Rect{});
+    }
+    size_ = size;
+  }
+
+  void push(const Rect &r) {
+    if (size_ == capacity_) {
+      reserve(capacity_ == 0 ? kLanes : capacity_ * 2);
+    }
+    set(size_++, r);
+  }
+
+  [[nodiscard]] Rect get(std::size_t idx) const noexcept {
+    return Rect{xs()[idx], ys()[idx], widths()[idx], heights()[idx]};
+  }
+
+  void set(std::size_t idx, const Rect &r) noexcept {
+    xs()[idx] = r.x;
+    ys()[idx] = r.y;
+    widths()[idx] = r.width;
+    heights()[idx] = r.height;
+  }
+
+  [[nodiscard]] int *xs() noexcept { return column(0); }
+  [[nodiscard]] int *ys() noexcept { return column(1); }
+  [[nodiscard]] int *widths() noexcept { return column(2); }
+  [[nodiscard]] int *heights() noexcept { return column(3); }
+  [[nodiscard]] const int *xs() const noexcept { return column(0); }
+  [[nodiscard]] const int *ys() const noexcept { return column(1); }
+  [[nodiscard]] const int *widths() const noexcept { return column(2); }
+  [[nodiscard]] const int *heights() const noexcept { return column(3); }
+
+  // Writes intersect(get(i), clip) for every element into `out`.
+  void intersectAll(const Rect &clip, RectSoA &out) const {
+    out.resize(size_);
+    const detail::rectsoa::Columns dst = out.columns();
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::intersectAvx2(columns(), dst, size_, clip);
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::intersectSse2(columns(), dst, size_, clip);
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::intersectScalar(columns(), dst, done, size_, clip);
+  }
+
+  // In-place variant of intersectAll.
+  void clipTo(const Rect &clip) noexcept {
+    const detail::rectsoa::Columns io = columns();
+    const detail::rectsoa::ConstColumns in{io.x, io.y, io.w, io.h};
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::intersectAvx2(in, io, size_, clip);
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::intersectSse2(in, io, size_, clip);
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::intersectScalar(in, io, done, size_, clip);
+  }
+
+  // Sets bit i of `mask` when element i contains the point. Elements beyond
+  // mask.size() * 64 are not tested. Returns the number of hits.
+  std::size_t containsPoint(int px, int py,
+                            Span<std::uint64_t> mask) const noexcept {
+    const std::size_t n = std::min(size_, mask.size() * 64);
+    const std::size_t words = (n + 63) / 64;
+    for (std::size_t k = 0; k < words; ++k) {
+      mask[k] = 0;
+    }
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::containsAvx2(columns(), n, px, py, mask.data());
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::containsSse2(columns(), n, px, py, mask.data());
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::containsScalar(columns(), done, n, px, py, mask.data());
+    std::size_t hits = 0;
+    for (std::size_t k = 0; k < words; ++k) {
+      hits += static_cast<std::size_t>(std::popcount(mask[k]));
+    }
+    return hits;
+  }
+
+  // Writes the area of each element (0 for empty rects) into `out`, up to
+  // out.size() elements.
+  void areas(Span<std::int64_t> out) const noexcept {
+    const std::size_t n = std::min(size_, out.size());
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::areasAvx2(columns(), n, out.data());
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::areasSse2(columns(), n, out.data());
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::areasScalar(columns(), done, n, out.data());
+  }
+
+  // Union of all non-empty elements; an empty Rect when there are none.
+  [[nodiscard]] Rect bounds() const noexcept {
+    detail::rectsoa::Extent ext;
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::boundsAvx2(columns(), size_, ext);
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::boundsSse2(columns(), size_, ext);
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::boundsScalar(columns(), done, size_, ext);
+    return ext.toRect();
+  }
+
+  void translate(int dx, int dy) noexcept {
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::translateAvx2(columns(), size_, dx, dy);
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::translateSse2(columns(), size_, dx, dy);
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::translateScalar(columns(), done, size_, dx, dy);
+  }
+
+  // Scales positions and extents, rounding to nearest (ties to even).
+  void scale(float sx, float sy) noexcept {
+    std::size_t done = 0;
+#if DAKT_SIMD_X86
+    switch (simdLevel()) {
+    case SimdLevel::AVX2:
+      done = detail::rectsoa::scaleAvx2(columns(), size_, sx, sy);
+      break;
+    case SimdLevel::SSE2:
+      done = detail::rectsoa::scaleSse2(columns(), size_, sx, sy);
+      break;
+    case SimdLevel::Scalar:
+      break;
+    }
+#endif
+    detail::rectsoa::scaleScalar(columns(), done, size_, sx, sy);
+  }
+
+private:
+  static constexpr std::size_t kLanes = 8;
+  static constexpr std::size_t kAlignment = 32;
+
+  [[nodiscard]] int *column(std::size_t c) const noexcept {
+    return block_ + c * capacity_;
+  }
+
+  [[nodiscard]] detail::rectsoa::Columns columns() noexcept {
+    return {column(0), column(1), column(2), column(3)};
+  }
+  [[nodiscard]] detail::rectsoa::ConstColumns columns() const noexcept {
+    return {column(0), column(1), column(2), column(3)};
+  }
+
+  void release() noexcept {
+    if (block_ != nullptr) {
+      allocator_->deallocate(block_, capacity_ * 4 * sizeof(int));
+      block_ = nullptr;
+      capacity_ = 0;
+    }
+  }
+
+  IAllocator *allocator_;
+  int *block_{nullptr};
+  std::size_t size_{0};
+  std::size_t capacity_{0};
+};
+
+} // namespace dakt::core
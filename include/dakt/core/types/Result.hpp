@@ -1,14 +1,19 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <type_traits>
 #include <utility>
 #include <variant>
 
+#include "ErrorCode.hpp"
+
 namespace dakt::core {
 
+// Holds either a value or an error. Result is trivially copyable whenever T
+// and E are, so small Results are passed and returned in registers.
 template <typename T, typename E> class Result {
 public:
   using value_type = T;
@@ -33,38 +38,51 @@ public:
   [[nodiscard]] const E &error() const & { return std::get<1>(data_); }
   [[nodiscard]] E &&error() && { return std::move(std::get<1>(data_)); }
 
-  template <typename F>
-  auto map(F &&f) -> Result<std::invoke_result_t<F, T>, E> {
-    using U = std::invoke_result_t<F, T>;
-    if (isOk()) {
-      return Result<U, E>::ok(std::invoke(std::forward<F>(f), value()));
-    }
-    return Result<U, E>::err(error());
+  // Monadic operations come in &, const & and && forms. Called on an
+  // rvalue (the usual case in a chain), the value and error are moved into
+  // the callback and the next Result instead of copied, so move-only T works.
+  template <typename F> auto map(F &&f) & {
+    return mapImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto map(F &&f) const & {
+    return mapImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto map(F &&f) && {
+    return mapImpl(std::move(*this), std::forward<F>(f));
   }
 
-  template <typename F> auto andThen(F &&f) -> std::invoke_result_t<F, T> {
-    using Ret = std::invoke_result_t<F, T>;
-    if (isOk()) {
-      return std::invoke(std::forward<F>(f), value());
-    }
-    return Ret::err(error());
+  template <typename F> auto andThen(F &&f) & {
+    return andThenImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto andThen(F &&f) const & {
+    return andThenImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto andThen(F &&f) && {
+    return andThenImpl(std::move(*this), std::forward<F>(f));
   }
 
-  template <typename F>
-  auto orElse(F &&f) -> Result<T, std::invoke_result_t<F, E>> {
-    using Err = std::invoke_result_t<F, E>;
-    if (isErr()) {
-      return Result<T, Err>::err(std::invoke(std::forward<F>(f), error()));
-    }
-    return Result<T, Err>::ok(value());
+  template <typename F> auto orElse(F &&f) & {
+    return orElseImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto orElse(F &&f) const & {
+    return orElseImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto orElse(F &&f) && {
+    return orElseImpl(std::move(*this), std::forward<F>(f));
   }
 
-  [[nodiscard]] T valueOr(T defaultVal) const {
+  [[nodiscard]] T valueOr(T defaultVal) const & {
     if (isOk()) {
       return std::get<0>(data_);
     }
     return defaultVal;
   }
+  [[nodiscard]] T valueOr(T defaultVal) && {
+    if (isOk()) {
+      return std::move(std::get<0>(data_));
+    }
+    return defaultVal;
+  }
 
   explicit operator bool() const noexcept { return isOk(); }
 
@@ -73,6 +91,49 @@ private:
   explicit Result(std::in_place_index_t<I> index, Args &&...args)
       : data_(index, std::forward<Args>(args)...) {}
 
+  // `Self` is Result &, const Result & or Result; forwarding it through
+  // value()/error() picks the copying or moving accessor.
+  template <typename Self, typename F>
+  static auto mapImpl(Self &&self, F &&f) {
+    using V = decltype(std::forward<Self>(self).value());
+    using U = std::remove_cvref_t<std::invoke_result_t<F, V>>;
+    if (self.isOk()) {
+      if constexpr (std::is_void_v<U>) {
+        std::invoke(std::forward<F>(f), std::forward<Self>(self).value());
+        return Result<void, E>::ok();
+      } else {
+        return Result<U, E>::ok(
+            std::invoke(std::forward<F>(f), std::forward<Self>(self).value()));
+      }
+    }
+    if constexpr (std::is_void_v<U>) {
+      return Result<void, E>::err(std::forward<Self>(self).error());
+    } else {
+      return Result<U, E>::err(std::forward<Self>(self).error());
+    }
+  }
+
+  template <typename Self, typename F>
+  static auto andThenImpl(Self &&self, F &&f) {
+    using V = decltype(std::forward<Self>(self).value());
+    using Ret = std::remove_cvref_t<std::invoke_result_t<F, V>>;
+    if (self.isOk()) {
+      return std::invoke(std::forward<F>(f), std::forward<Self>(self).value());
+    }
+    return Ret::err(std::forward<Self>(self).error());
+  }
+
+  template <typename Self, typename F>
+  static auto orElseImpl(Self &&self, F &&f) {
+    using G = decltype(std::forward<Self>(self).error());
+    using Err = std::remove_cvref_t<std::invoke_result_t<F, G>>;
+    if (self.isErr()) {
+      return Result<T, Err>::err(
+          std::invoke(std::forward<F>(f), std::forward<Self>(self).error()));
+    }
+    return Result<T, Err>::ok(std::forward<Self>(self).value());
+  }
+
   std::variant<T, E> data_;
 };
 
@@ -80,33 +141,218 @@ template <typename E> class Result<void, E> {
 public:
   using error_type = E;
 
-  static Result ok() { return Result(true, std::nullopt); }
-  static Result err(E error) { return Result(false, std::move(error)); }
+  static Result ok() { return Result(std::nullopt); }
+  static Result err(E error) { return Result(std::move(error)); }
 
-  [[nodiscard]] bool isOk() const noexcept { return ok_; }
-  [[nodiscard]] bool isErr() const noexcept { return !ok_; }
+  [[nodiscard]] bool isOk() const noexcept { return !error_.has_value(); }
+  [[nodiscard]] bool isErr() const noexcept { return error_.has_value(); }
 
   [[nodiscard]] E &error() & { return *error_; }
   [[nodiscard]] const E &error() const & { return *error_; }
   [[nodiscard]] E &&error() && { return std::move(*error_); }
 
+  // `f` takes no arguments; a void `f` maps to Result<void, E>.
+  template <typename F> auto map(F &&f) const & {
+    return mapImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto map(F &&f) && {
+    return mapImpl(std::move(*this), std::forward<F>(f));
+  }
+
+  template <typename F> auto andThen(F &&f) const & {
+    using Ret = std::remove_cvref_t<std::invoke_result_t<F>>;
+    if (isOk()) {
+      return std::invoke(std::forward<F>(f));
+    }
+    return Ret::err(*error_);
+  }
+  template <typename F> auto andThen(F &&f) && {
+    using Ret = std::remove_cvref_t<std::invoke_result_t<F>>;
+    if (isOk()) {
+      return std::invoke(std::forward<F>(f));
+    }
+    return Ret::err(std::move(*error_));
+  }
+
+  template <typename F> auto orElse(F &&f) & {
+    return orElseImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto orElse(F &&f) const & {
+    return orElseImpl(*this, std::forward<F>(f));
+  }
+  template <typename F> auto orElse(F &&f) && {
+    return orElseImpl(std::move(*this), std::forward<F>(f));
+  }
+
+  explicit operator bool() const noexcept { return isOk(); }
+
+private:
+  explicit Result(std::optional<E> err) : error_(std::move(err)) {}
+
+  template <typename Self, typename F>
+  static auto mapImpl(Self &&self, F &&f) {
+    using U = std::remove_cvref_t<std::invoke_result_t<F>>;
+    if (self.isOk()) {
+      if constexpr (std::is_void_v<U>) {
+        std::invoke(std::forward<F>(f));
+        return Result<void, E>::ok();
+      } else {
+        return Result<U, E>::ok(std::invoke(std::forward<F>(f)));
+      }
+    }
+    return Result<U, E>::err(std::forward<Self>(self).error());
+  }
+
+  template <typename Self, typename F>
+  static auto orElseImpl(Self &&self, F &&f) {
+    using G = decltype(std::forward<Self>(self).error());
+    using Err = std::remove_cvref_t<std::invoke_result_t<F, G>>;
+    if (self.isErr()) {
+      return Result<void, Err>::err(
+          std::invoke(std::forward<F>(f), std::forward<Self>(self).error()));
+    }
+    return Result<void, Err>::ok();
+  }
+
+  std::optional<E> error_{};
+};
+
+template <> class Result<void, ErrorCode>;
+
+// Pointer results with an ErrorCode share one word. User-space pointers on
+// the supported 64-bit targets have bit 63 clear, and ErrorCode never uses
+// it, so an error is stored with that bit set. The layout does not depend on
+// T, which may be incomplete. value() and error() return by value.
+template <typename T>
+  requires(sizeof(std::uintptr_t) == sizeof(std::uint64_t))
+class Result<T *, ErrorCode> {
+public:
+  using value_type = T *;
+  using error_type = ErrorCode;
+
+  static Result ok(T *value) noexcept {
+    return Result(reinterpret_cast<std::uintptr_t>(value));
+  }
+  static Result err(ErrorCode error) noexcept {
+    return Result(error.bits() | kErr);
+  }
+
+  [[nodiscard]] bool isOk() const noexcept { return (bits_ & kErr) == 0; }
+  [[nodiscard]] bool isErr() const noexcept { return (bits_ & kErr) != 0; }
+
+  [[nodiscard]] T *value() const noexcept {
+    return reinterpret_cast<T *>(bits_);
+  }
+  [[nodiscard]] ErrorCode error() const noexcept {
+    return ErrorCode::fromBits(bits_ & ~kErr);
+  }
+
+  template <typename F> auto map(F &&f) const {
+    using U = std::remove_cvref_t<std::invoke_result_t<F, T *>>;
+    if (isOk()) {
+      if constexpr (std::is_void_v<U>) {
+        std::invoke(std::forward<F>(f), value());
+        return Result<U, ErrorCode>::ok();
+      } else {
+        return Result<U, ErrorCode>::ok(
+            std::invoke(std::forward<F>(f), value()));
+      }
+    }
+    return Result<U, ErrorCode>::err(error());
+  }
+
+  template <typename F>
+  auto andThen(F &&f) const -> std::invoke_result_t<F, T *> {
+    using Ret = std::invoke_result_t<F, T *>;
+    if (isOk()) {
+      return std::invoke(std::forward<F>(f), value());
+    }
+    return Ret::err(error());
+  }
+
+  template <typename F>
+  auto orElse(F &&f) const -> Result<T *, std::invoke_result_t<F, ErrorCode>> {
+    using Err = std::invoke_result_t<F, ErrorCode>;
+    if (isErr()) {
+      return Result<T *, Err>::err(std::invoke(std::forward<F>(f), error()));
+    }
+    return Result<T *, Err>::ok(value());
+  }
+
+  [[nodiscard]] T *valueOr(T *defaultVal) const noexcept {
+    return isOk() ? value() : defaultVal;
+  }
+
+  explicit operator bool() const noexcept { return isOk(); }
+
+private:
+  static constexpr std::uintptr_t kErr = std::uintptr_t{1} << 63;
+
+  explicit Result(std::uintptr_t bits) noexcept : bits_(bits) {}
+
+  std::uintptr_t bits_;
+};
+
+// Success is the one bit pattern ErrorCode never produces.
+template <> class Result<void, ErrorCode> {
+public:
+  using error_type = ErrorCode;
+
+  static Result ok() noexcept { return Result(kOk); }
+  static Result err(ErrorCode error) noexcept { return Result(error.bits()); }
+
+  [[nodiscard]] bool isOk() const noexcept { return bits_ == kOk; }
+  [[nodiscard]] bool isErr() const noexcept { return bits_ != kOk; }
+
+  [[nodiscard]] ErrorCode error() const noexcept {
+    return ErrorCode::fromBits(bits_);
+  }
+
+  template <typename F> auto map(F &&f) const {
+    using U = std::remove_cvref_t<std::invoke_result_t<F>>;
+    if (isOk()) {
+      if constexpr (std::is_void_v<U>) {
+        std::invoke(std::forward<F>(f));
+        return Result<void, ErrorCode>::ok();
+      } else {
+        return Result<U, ErrorCode>::ok(std::invoke(std::forward<F>(f)));
+      }
+    }
+    return Result<U, ErrorCode>::err(error());
+  }
+
+  template <typename F> auto andThen(F &&f) const {
+    using Ret = std::remove_cvref_t<std::invoke_result_t<F>>;
+    if (isOk()) {
+      return std::invoke(std::forward<F>(f));
+    }
+    return Ret::err(error());
+  }
+
   template <typename F>
-  auto orElse(F &&f) -> Result<void, std::invoke_result_t<F, E>> {
-    using Err = std::invoke_result_t<F, E>;
+  auto orElse(F &&f) const -> Result<void, std::invoke_result_t<F, ErrorCode>> {
+    using Err = std::invoke_result_t<F, ErrorCode>;
     if (isErr()) {
-      return Result<void, Err>::err(std::invoke(std::forward<F>(f), *error_));
+      return Result<void, Err>::err(std::invoke(std::forward<F>(f), error()));
     }
     return Result<void, Err>::ok();
   }
 
-  explicit operator bool() const noexcept { return ok_; }
+  explicit operator bool() const noexcept { return isOk(); }
 
 private:
-  explicit Result(bool ok, std::optional<E> err)
-      : ok_(ok), error_(std::move(err)) {}
+  static constexpr std::uint64_t kOk = std::uint64_t{1} << 63;
 
-  bool ok_{false};
-  std::optional<E> error_{};
+  explicit Result(std::uint64_t bits) noexcept : bits_(bits) {}
+
+  std::uint64_t bits_;
 };
 
+static_assert(sizeof(Result<int *, ErrorCode>) == sizeof(int *));
+static_assert(sizeof(Result<char *, ErrorCode>) == sizeof(char *));
+static_assert(sizeof(Result<void, ErrorCode>) == sizeof(std::uint64_t));
+static_assert(std::is_trivially_copyable_v<Result<int *, ErrorCode>>);
+static_assert(std::is_trivially_copyable_v<Result<int, ErrorCode>>);
+static_assert(std::is_trivially_copyable_v<Result<void, ErrorCode>>);
+
 } // namespace dakt::core
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../interfaces/IAllocator.hpp"
+#include "Result.hpp"
+#include "SpanRanges.hpp"
+
+namespace dakt::core {
+
+namespace detail::batch {
+
+template <typename R> struct ResultTraits;
+template <typename T, typename E> struct ResultTraits<Result<T, E>> {
+  using Value = T;
+  using Error = E;
+};
+
+template <typename Range>
+using ResultOf = std::remove_cvref_t<std::ranges::range_reference_t<Range>>;
+template <typename Range>
+using ValueOf = typename ResultTraits<ResultOf<Range>>::Value;
+template <typename Range>
+using ErrorOf = typename ResultTraits<ResultOf<Range>>::Error;
+
+// Moves out of the element when the range yields rvalues or is an owning
+// container passed as an rvalue, copies otherwise. Views and borrowed ranges
+// (Span, filter_view, ...) refer to the caller's storage even as prvalues.
+template <typename Range, typename Ref>
+decltype(auto) forwardElement(Ref &&element) {
+  if constexpr (std::is_rvalue_reference_v<
+                    std::ranges::range_reference_t<Range>> ||
+                (!std::is_lvalue_reference_v<Range> &&
+                 !std::ranges::view<std::remove_cvref_t<Range>> &&
+                 !std::ranges::borrowed_range<Range>)) {
+    return std::move(element);
+  } else {
+    return static_cast<Ref &&>(element);
+  }
+}
+
+} // namespace detail::batch
+
+// Appends every value of `results` to `out` (whose capacity is reused) and
+// returns the first error instead if there is one; `out` then holds the values
+// before it.
+template <std::ranges::input_range Range>
+Result<void, detail::batch::ErrorOf<Range>>
+collectInto(Range &&results, std::vector<detail::batch::ValueOf<Range>> &out) {
+  using E = detail::batch::ErrorOf<Range>;
+  if constexpr (std::ranges::sized_range<Range>) {
+    out.reserve(out.size() + std::ranges::size(results));
+  }
+  for (auto &&r : results) {
+    auto &&item = detail::batch::forwardElement<Range>(r);
+    if (item.isErr()) {
+      return Result<void, E>::err(
+          std::forward<decltype(item)>(item).error());
+    }
+    out.push_back(std::forward<decltype(item)>(item).value());
+  }
+  return Result<void, E>::ok();
+}
+
+// Range of Result<T, E> to Result<std::vector<T>, E>, stopping at the first
+// error. The vector is reserved up front for sized ranges.
+template <std::ranges::input_range Range>
+Result<std::vector<detail::batch::ValueOf<Range>>, detail::batch::ErrorOf<Range>>
+collect(Range &&results) {
+  using T = detail::batch::ValueOf<Range>;
+  using E = detail::batch::ErrorOf<Range>;
+  std::vector<T> values;
+  auto status = collectInto(std::forward<Range>(results), values);
+  if (status.isErr()) {
+    return Result<std::vector<T>, E>::err(std::move(status).error());
+  }
+  return Result<std::vector<T>, E>::ok(std::move(values));
+}
+
+struct PartitionCounts {
+  std::size_t ok{0};
+  std::size_t err{0};
+  // Items that did not fit in the span for their kind.
+  std::size_t dropped{0};
+};
+
+// Splits `results` into `values` and `errors` in order, without allocating.
+template <std::ranges::input_range Range>
+PartitionCounts partition(Range &&results,
+                          Span<detail::batch::ValueOf<Range>> values,
+                          Span<detail::batch::ErrorOf<Range>> errors) {
+  PartitionCounts counts;
+  for (auto &&r : results) {
+    auto &&item = detail::batch::forwardElement<Range>(r);
+    if (item.isOk()) {
+      if (counts.ok < values.size()) {
+        values[counts.ok++] = std::forward<decltype(item)>(item).value();
+      } else {
+        ++counts.dropped;
+      }
+    } else if (counts.err < errors.size()) {
+      errors[counts.err++] = std::forward<decltype(item)>(item).error();
+    } else {
+      ++counts.dropped;
+    }
+  }
+  return counts;
+}
+
+// Validity of each element of a batch, one bit per element (bit i % 64 of
+// word i / 64). The words are exposed so vectorized kernels that already
+// produce bitmasks (RectSoA::containsPoint, diffTiles) can fill the batch
+// directly. Bits past size() are always zero.
+class ResultBatch {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  ResultBatch(IAllocator &allocator, std::size_t size,
+              bool initiallyValid = false)
+      : allocator_(&allocator), size_(size), wordCount_((size + 63) / 64) {
+    if (wordCount_ > 0) {
+      words_ = static_cast<std::uint64_t *>(allocator_->allocate(
+          wordCount_ * sizeof(std::uint64_t), alignof(std::uint64_t)));
+    }
+    fill(initiallyValid);
+  }
+
+  ResultBatch(const ResultBatch &) = delete;
+  ResultBatch &operator=(const ResultBatch &) = delete;
+
+  ResultBatch(ResultBatch &&other) noexcept
+      : allocator_(other.allocator_), words_(std::exchange(other.words_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        wordCount_(std::exchange(other.wordCount_, 0)) {}
+
+  ResultBatch &operator=(ResultBatch &&other) noexcept {
+    if (this != &other) {
+      release();
+      allocator_ = other.allocator_;
+      words_ = std::exchange(other.words_, nullptr);
+      size_ = std::exchange(other.size_, 0);
+      wordCount_ = std::exchange(other.wordCount_, 0);
+    }
+    return *this;
+  }
+
+  ~ResultBatch() { release(); }
+
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+  [[nodiscard]] Span<std::uint64_t> words() noexcept {
+    return {words_, wordCount_};
+  }
+  [[nodiscard]] Span<const std::uint64_t> words() const noexcept {
+    return {words_, wordCount_};
+  }
+
+  [[nodiscard]] bool valid(std::size_t i) const noexcept {
+    return ((words_[i >> 6] >> (i & 63)) & 1u) != 0;
+  }
+
+  void set(std::size_t i, bool ok) noexcept {
+    const std::uint64_t bit = std::uint64_t{1} << (i & 63);
+    words_[i >> 6] = ok ? (words_[i >> 6] | bit) : (words_[i >> 6] & ~bit);
+  }
+
+  void fill(bool ok) noexcept {
+    if (wordCount_ > 0) {
+      std::memset(words_, ok ? 0xFF : 0, wordCount_ * sizeof(std::uint64_t));
+      clearTail();
+    }
+  }
+
+  // Sets bit i to pred(items[i]). Each word is assembled from 64 predicate
+  // results without branches, which compilers vectorize for simple
+  // predicates. items.size() must equal size().
+  template <typename T, typename Pred>
+  void evaluate(Span<const T> items, Pred &&pred) {
+    for (std::size_t w = 0; w < wordCount_; ++w) {
+      const std::size_t base = w * 64;
+      const std::size_t n = size_ - base < 64 ? size_ - base : 64;
+      std::uint64_t word = 0;
+      for (std::size_t b = 0; b < n; ++b) {
+        word |= std::uint64_t{static_cast<bool>(pred(items[base + b]))} << b;
+      }
+      words_[w] = word;
+    }
+  }
+
+  // Records which elements of a range of Results are ok.
+  template <std::ranges::input_range Range> void record(const Range &results) {
+    std::size_t i = 0;
+    for (const auto &r : results) {
+      if (i == size_) {
+        break;
+      }
+      set(i++, r.isOk());
+    }
+  }
+
+  [[nodiscard]] std::size_t validCount() const noexcept {
+    std::size_t n = 0;
+    for (std::size_t w = 0; w < wordCount_; ++w) {
+      n += static_cast<std::size_t>(std::popcount(words_[w]));
+    }
+    return n;
+  }
+  [[nodiscard]] std::size_t invalidCount() const noexcept {
+    return size_ - validCount();
+  }
+  [[nodiscard]] bool allValid() const noexcept {
+    return firstInvalid() == npos;
+  }
+
+  [[nodiscard]] std::size_t firstInvalid() const noexcept {
+    for (std::size_t w = 0; w < wordCount_; ++w) {
+      const std::uint64_t invalid = ~words_[w] & tailMask(w);
+      if (invalid != 0) {
+        return w * 64 + static_cast<std::size_t>(std::countr_zero(invalid));
+      }
+    }
+    return npos;
+  }
+
+  template <typename F> void forEachValid(F &&f) const {
+    for (std::size_t w = 0; w < wordCount_; ++w) {
+      for (std::uint64_t bits = words_[w]; bits != 0; bits &= bits - 1) {
+        f(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+      }
+    }
+  }
+
+  template <typename F> void forEachInvalid(F &&f) const {
+    for (std::size_t w = 0; w < wordCount_; ++w) {
+      for (std::uint64_t bits = ~words_[w] & tailMask(w); bits != 0;
+           bits &= bits - 1) {
+        f(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+      }
+    }
+  }
+
+  // Copies the valid elements of `items` to the front of `out` in order and
+  // returns how many were copied (at most out.size()).
+  template <typename T>
+  std::size_t compact(Span<const T> items, Span<T> out) const {
+    std::size_t n = 0;
+    for (std::size_t w = 0; w < wordCount_; ++w) {
+      for (std::uint64_t bits = words_[w]; bits != 0 && n < out.size();
+           bits &= bits - 1) {
+        out[n++] = items[w * 64 + static_cast<std::size_t>(
+                                      std::countr_zero(bits))];
+      }
+    }
+    return n;
+  }
+
+private:
+  [[nodiscard]] std::uint64_t tailMask(std::size_t w) const noexcept {
+    const std::size_t rem = size_ - w * 64;
+    return rem >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << rem) - 1;
+  }
+
+  void clearTail() noexcept {
+    words_[wordCount_ - 1] &= tailMask(wordCount_ - 1);
+  }
+
+  void release() noexcept {
+    if (words_ != nullptr) {
+      allocator_->deallocate(words_, wordCount_ * sizeof(std::uint64_t));
+      words_ = nullptr;
+    }
+  }
+
+  IAllocator *allocator_;
+  std::uint64_t *words_{nullptr};
+  std::size_t size_{0};
+  std::size_t wordCount_{0};
+};
+
+} // namespace dakt::core
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <ranges>
+
+#include "Span.hpp"
+
+// Kept out of Span.hpp so plain Span users do not pay for <ranges>. Include
+// this before handing a Span to std::ranges code that cares whether the range
+// is borrowed.
+
+// A Span never owns its elements, so iterators taken from a temporary one
+// stay valid.
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<dakt::core::Span<T>> =
+    true;
@@ -5,6 +5,8 @@
 #include <string>
 #include <string_view>
 
+#include "../text/StringScan.hpp"
+
 namespace dakt::core {
 
 class StringView {
@@ -41,12 +43,21 @@ public:
 
   [[nodiscard]] constexpr std::size_t find(char c,
                                            std::size_t pos = 0) const noexcept {
-    for (std::size_t i = pos; i < size_; ++i) {
-      if (data_[i] == c) {
-        return i;
+    if (pos >= size_) {
+      return npos;
+    }
+    if consteval {
+      for (std::size_t i = pos; i < size_; ++i) {
+        if (data_[i] == c) {
+          return i;
+        }
       }
+      return npos;
+    } else {
+      const std::size_t i =
+          detail::strsearch::findChar(data_ + pos, size_ - pos, c);
+      return i == npos ? npos : pos + i;
     }
-    return npos;
   }
 
   [[nodiscard]] constexpr std::size_t find(StringView sv,
@@ -54,16 +65,105 @@ public:
     if (sv.size_ == 0) {
       return pos <= size_ ? pos : npos;
     }
+    if (pos > size_ || sv.size_ > size_ - pos) {
+      return npos;
+    }
+    if consteval {
+      for (std::size_t i = pos; i + sv.size_ <= size_; ++i) {
+        if (std::string_view(data_ + i, sv.size_) ==
+            std::string_view(sv.data_, sv.size_)) {
+          return i;
+        }
+      }
+      return npos;
+    } else {
+      const std::size_t i = detail::strsearch::find(data_ + pos, size_ - pos,
+                                                    sv.data_, sv.size_);
+      return i == npos ? npos : pos + i;
+    }
+  }
+
+  // Last occurrence starting at or before `pos`.
+  [[nodiscard]] constexpr std::size_t
+  rfind(char c, std::size_t pos = npos) const noexcept {
+    const std::size_t n = pos < size_ ? pos + 1 : size_;
+    if consteval {
+      for (std::size_t i = n; i-- > 0;) {
+        if (data_[i] == c) {
+          return i;
+        }
+      }
+      return npos;
+    } else {
+      return detail::strsearch::rfindChar(data_, n, c);
+    }
+  }
+
+  [[nodiscard]] constexpr std::size_t
+  rfind(StringView sv, std::size_t pos = npos) const noexcept {
     if (sv.size_ > size_) {
       return npos;
     }
-    for (std::size_t i = pos; i + sv.size_ <= size_; ++i) {
-      if (std::string_view(data_ + i, sv.size_) ==
-          std::string_view(sv.data_, sv.size_)) {
-        return i;
+    const std::size_t last = size_ - sv.size_ < pos ? size_ - sv.size_ : pos;
+    if (sv.size_ == 0) {
+      return last;
+    }
+    if consteval {
+      for (std::size_t i = last + 1; i-- > 0;) {
+        if (std::string_view(data_ + i, sv.size_) ==
+            std::string_view(sv.data_, sv.size_)) {
+          return i;
+        }
       }
+      return npos;
+    } else {
+      return detail::strsearch::rfind(data_, last + sv.size_, sv.data_,
+                                      sv.size_);
+    }
+  }
+
+  // First character at or after `pos` that appears in `set`.
+  [[nodiscard]] constexpr std::size_t
+  findFirstOf(StringView set, std::size_t pos = 0) const noexcept {
+    if (pos >= size_) {
+      return npos;
+    }
+    if consteval {
+      return std::string_view(data_, size_).find_first_of(
+          std::string_view(set.data_, set.size_), pos);
+    } else {
+      const std::size_t i = detail::strsearch::findFirstOf(
+          data_ + pos, size_ - pos, set.data_, set.size_);
+      return i == npos ? npos : pos + i;
+    }
+  }
+
+  // Last character at or before `pos` that appears in `set`.
+  [[nodiscard]] constexpr std::size_t
+  findLastOf(StringView set, std::size_t pos = npos) const noexcept {
+    const std::size_t n = pos < size_ ? pos + 1 : size_;
+    if consteval {
+      return std::string_view(data_, n).find_last_of(
+          std::string_view(set.data_, set.size_));
+    } else {
+      return detail::strsearch::findLastOf(data_, n, set.data_, set.size_);
+    }
+  }
+
+  // First character at or after `pos` that does not appear in `set`.
+  [[nodiscard]] constexpr std::size_t
+  findFirstNotOf(StringView set, std::size_t pos = 0) const noexcept {
+    if (pos >= size_) {
+      return npos;
+    }
+    if consteval {
+      return std::string_view(data_, size_).find_first_not_of(
+          std::string_view(set.data_, set.size_), pos);
+    } else {
+      const std::size_t i = detail::strsearch::findFirstNotOf(
+          data_ + pos, size_ - pos, set.data_, set.size_);
+      return i == npos ? npos : pos + i;
     }
-    return npos;
   }
 
   [[nodiscard]] constexpr bool operator==(StringView other) const noexcept {
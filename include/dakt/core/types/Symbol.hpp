@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../hash/Hash.hpp"
+
+namespace dakt::core {
+
+// Handle to an interned string. Two symbols from the same interner are equal
+// exactly when their strings are; the default symbol is "none".
+struct Symbol {
+  std::uint32_t value{0};
+
+  [[nodiscard]] constexpr bool valid() const noexcept { return value != 0; }
+  constexpr explicit operator bool() const noexcept { return valid(); }
+  constexpr bool operator==(const Symbol &) const noexcept = default;
+};
+
+struct SymbolHash {
+  [[nodiscard]] std::size_t operator()(Symbol s) const noexcept {
+    return static_cast<std::size_t>(hashCombine(s.value, 0));
+  }
+};
+
+} // namespace dakt::core
@@ -0,0 +1,236 @@
+#include "../../include/dakt/core/concurrency/EpochManager.hpp"
+
+#include <new>
+
+namespace dakt::core {
+
+namespace {
+
+constexpr std::size_t kBlockEntries = 62;
+constexpr std::uint32_t kCollectInterval = 64;
+
+} // namespace
+
+struct EpochManager::Block {
+  Block *next;
+  std::uint64_t epoch;
+  std::size_t used;
+  detail::reclaim::Retired entries[kBlockEntries];
+};
+
+EpochManager::EpochManager(IAllocator &allocator)
+    : allocator_(allocator),
+      link_(detail::reclaim::openDomainLink(this, &releaseThreadRecord)) {}
+
+EpochManager::~EpochManager() {
+  detail::reclaim::closeDomainLink(link_);
+  auto freeBlocks = [this](Block *b) {
+    while (b != nullptr) {
+      Block *next = b->next;
+      for (std::size_t i = 0; i < b->used; ++i) {
+        b->entries[i].reclaim(allocator_);
+      }
+      allocator_.deallocate(b, sizeof(Block));
+      b = next;
+    }
+  };
+  freeBlocks(orphans_);
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;) {
+    Record *next = r->next;
+    for (Bag &bag : r->bags) {
+      freeBlocks(bag.blocks);
+    }
+    if (r->spare != nullptr) {
+      allocator_.deallocate(r->spare, sizeof(Block));
+    }
+    r->~Record();
+    allocator_.deallocate(r, sizeof(Record));
+    r = next;
+  }
+}
+
+EpochManager::Record &EpochManager::localRecord() {
+  if (void *cached = detail::reclaim::findThreadRecord(link_)) {
+    return *static_cast<Record *>(cached);
+  }
+  Record *record = acquireRecord();
+  detail::reclaim::setThreadRecord(link_, record);
+  return *record;
+}
+
+// Reuses a record released by an exited thread, or adds a new one. Records
+// are never unlinked before the manager dies, so the list can be walked
+// without locks.
+EpochManager::Record *EpochManager::acquireRecord() {
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;
+       r = r->next) {
+    bool expected = false;
+    if (!r->owned.load(std::memory_order_relaxed) &&
+        r->owned.compare_exchange_strong(expected, true,
+                                         std::memory_order_acquire)) {
+      return r;
+    }
+  }
+  auto *record = ::new (allocator_.allocate(sizeof(Record), alignof(Record)))
+      Record();
+  record->owned.store(true, std::memory_order_relaxed);
+  Record *head = records_.load(std::memory_order_relaxed);
+  do {
+    record->next = head;
+  } while (!records_.compare_exchange_weak(head, record,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+  return record;
+}
+
+// Called at thread exit: the blocks still waiting for their epoch move to
+// the orphan list, which collect() drains.
+void EpochManager::releaseRecord(Record &record) noexcept {
+  const std::lock_guard<std::mutex> lock(orphanMutex_);
+  for (Bag &bag : record.bags) {
+    while (Block *b = bag.blocks) {
+      bag.blocks = b->next;
+      b->next = orphans_;
+      orphans_ = b;
+    }
+    bag.epoch = 0;
+  }
+  orphanPending_.fetch_add(record.pending.exchange(0, std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+  if (record.spare != nullptr) {
+    allocator_.deallocate(record.spare, sizeof(Block));
+    record.spare = nullptr;
+  }
+  record.nesting = 0;
+  record.sinceCollect = 0;
+  record.state.store(0, std::memory_order_release);
+  record.owned.store(false, std::memory_order_release);
+}
+
+void EpochManager::releaseThreadRecord(void *manager, void *record) noexcept {
+  static_cast<EpochManager *>(manager)->releaseRecord(
+      *static_cast<Record *>(record));
+}
+
+void EpochManager::retire(void *ptr, ReclaimFn fn, std::size_t arg) {
+  Record &record = localRecord();
+  // The node was unlinked before this call. The fence orders that before the
+  // epoch load, so the tag is at least the epoch of any reader that could
+  // still have reached the node.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const std::uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+
+  Bag &bag = record.bags[epoch % 3];
+  if (bag.epoch != epoch) {
+    // Same slot three epochs ago, hence expired.
+    freeBag(record, bag);
+    bag.epoch = epoch;
+  }
+  Block *block = bag.blocks;
+  if (block == nullptr || block->used == kBlockEntries) {
+    block = std::exchange(record.spare, nullptr);
+    if (block == nullptr) {
+      block = static_cast<Block *>(
+          allocator_.allocate(sizeof(Block), alignof(Block)));
+    }
+    block->next = bag.blocks;
+    block->epoch = epoch;
+    block->used = 0;
+    bag.blocks = block;
+  }
+  block->entries[block->used++] = {ptr, fn, arg};
+  record.pending.fetch_add(1, std::memory_order_relaxed);
+
+  if (++record.sinceCollect >= kCollectInterval) {
+    record.sinceCollect = 0;
+    collect();
+  }
+}
+
+void EpochManager::collect() {
+  Record &record = localRecord();
+  tryAdvance();
+  const std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  for (Bag &bag : record.bags) {
+    if (bag.blocks != nullptr && bag.epoch + 2 <= epoch) {
+      freeBag(record, bag);
+    }
+  }
+  if (orphanPending_.load(std::memory_order_relaxed) != 0) {
+    collectOrphans();
+  }
+}
+
+std::size_t EpochManager::pendingCount() const noexcept {
+  std::size_t n = orphanPending_.load(std::memory_order_relaxed);
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;
+       r = r->next) {
+    n += r->pending.load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+// Advances the epoch if every pinned thread has seen the current one.
+bool EpochManager::tryAdvance() noexcept {
+  std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;
+       r = r->next) {
+    const std::uint64_t state = r->state.load(std::memory_order_seq_cst);
+    if ((state & 1) != 0 && (state >> 1) != epoch) {
+      return false;
+    }
+  }
+  return epoch_.compare_exchange_strong(epoch, epoch + 1,
+                                        std::memory_order_seq_cst);
+}
+
+// Runs the reclaimers of a block chain and frees the blocks, keeping one as
+// the owner's spare. Returns the number of entries reclaimed.
+std::size_t EpochManager::reclaimBlocks(Block *blocks,
+                                        Record *owner) noexcept {
+  std::size_t n = 0;
+  while (blocks != nullptr) {
+    Block *next = blocks->next;
+    for (std::size_t i = 0; i < blocks->used; ++i) {
+      blocks->entries[i].reclaim(allocator_);
+    }
+    n += blocks->used;
+    if (owner != nullptr && owner->spare == nullptr) {
+      owner->spare = blocks;
+    } else {
+      allocator_.deallocate(blocks, sizeof(Block));
+    }
+    blocks = next;
+  }
+  return n;
+}
+
+void EpochManager::freeBag(Record &owner, Bag &bag) noexcept {
+  const std::size_t n = reclaimBlocks(std::exchange(bag.blocks, nullptr),
+                                      &owner);
+  owner.pending.fetch_sub(n, std::memory_order_relaxed);
+}
+
+void EpochManager::collectOrphans() noexcept {
+  std::unique_lock<std::mutex> lock(orphanMutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return;
+  }
+  const std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  Block *expired = nullptr;
+  for (Block **link = &orphans_; *link != nullptr;) {
+    Block *b = *link;
+    if (b->epoch + 2 <= epoch) {
+      *link = b->next;
+      b->next = expired;
+      expired = b;
+    } else {
+      link = &b->next;
+    }
+  }
+  lock.unlock();
+  orphanPending_.fetch_sub(reclaimBlocks(expired, nullptr),
+                           std::memory_order_relaxed);
+}
+
+} // namespace dakt::core
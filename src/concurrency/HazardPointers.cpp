@@ -0,0 +1,301 @@
+#include "../../include/dakt/core/concurrency/HazardPointers.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <new>
+
+namespace dakt::core {
+
+namespace {
+
+constexpr std::size_t kScanThreshold = 64;
+constexpr std::size_t kInitialListCapacity = 64;
+
+} // namespace
+
+struct HazardDomain::RetiredList {
+  RetiredList *next;
+  std::size_t count;
+  std::size_t capacity;
+
+  // The entries follow the header in the same allocation.
+  detail::reclaim::Retired *entries() noexcept {
+    return reinterpret_cast<detail::reclaim::Retired *>(this + 1);
+  }
+  static std::size_t bytes(std::size_t capacity) noexcept {
+    return sizeof(RetiredList) + capacity * sizeof(detail::reclaim::Retired);
+  }
+};
+
+HazardDomain::HazardDomain(IAllocator &allocator)
+    : allocator_(allocator),
+      link_(detail::reclaim::openDomainLink(this, &releaseThreadRecord)) {}
+
+HazardDomain::~HazardDomain() {
+  detail::reclaim::closeDomainLink(link_);
+  auto reclaimAll = [this](RetiredList *list) {
+    for (std::size_t i = 0; i < list->count; ++i) {
+      list->entries()[i].reclaim(allocator_);
+    }
+    freeList(list);
+  };
+  while (RetiredList *list = orphans_) {
+    orphans_ = list->next;
+    reclaimAll(list);
+  }
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;) {
+    Record *next = r->next;
+    if (r->retired != nullptr) {
+      reclaimAll(r->retired);
+    }
+    if (r->hazards != nullptr) {
+      allocator_.deallocate(r->hazards, r->hazardCapacity * sizeof(void *));
+    }
+    r->~Record();
+    allocator_.deallocate(r, sizeof(Record));
+    r = next;
+  }
+}
+
+HazardDomain::Holder::Holder(HazardDomain &domain) {
+  Record &local = domain.localRecord();
+  if (local.freeSlots != 0) {
+    index_ = static_cast<std::uint32_t>(std::countr_zero(local.freeSlots));
+    local.freeSlots &= ~(1u << index_);
+    record_ = &local;
+    spare_ = false;
+  } else {
+    // All of the thread's slots are taken: borrow a whole record.
+    record_ = domain.acquireRecord();
+    index_ = 0;
+    spare_ = true;
+  }
+  slot_ = &record_->slots[index_];
+}
+
+HazardDomain::Holder::~Holder() {
+  if (slot_ == nullptr) {
+    return;
+  }
+  slot_->store(nullptr, std::memory_order_release);
+  if (spare_) {
+    record_->owned.store(false, std::memory_order_release);
+  } else {
+    record_->freeSlots |= 1u << index_;
+  }
+}
+
+HazardDomain::Record &HazardDomain::localRecord() {
+  if (void *cached = detail::reclaim::findThreadRecord(link_)) {
+    return *static_cast<Record *>(cached);
+  }
+  Record *record = acquireRecord();
+  detail::reclaim::setThreadRecord(link_, record);
+  return *record;
+}
+
+// Reuses a free record or adds a new one. Records are never unlinked before
+// the domain dies, so scans walk the list without locks.
+HazardDomain::Record *HazardDomain::acquireRecord() {
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;
+       r = r->next) {
+    bool expected = false;
+    if (!r->owned.load(std::memory_order_relaxed) &&
+        r->owned.compare_exchange_strong(expected, true,
+                                         std::memory_order_acquire)) {
+      return r;
+    }
+  }
+  auto *record = ::new (allocator_.allocate(sizeof(Record), alignof(Record)))
+      Record();
+  record->owned.store(true, std::memory_order_relaxed);
+  Record *head = records_.load(std::memory_order_relaxed);
+  do {
+    record->next = head;
+  } while (!records_.compare_exchange_weak(head, record,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed));
+  recordCount_.fetch_add(1, std::memory_order_relaxed);
+  return record;
+}
+
+// Called at thread exit: the thread's retired list moves to the orphan
+// list, which collect() drains.
+void HazardDomain::releaseRecord(Record &record) noexcept {
+  if (RetiredList *list = std::exchange(record.retired, nullptr)) {
+    if (list->count == 0) {
+      freeList(list);
+    } else {
+      const std::lock_guard<std::mutex> lock(orphanMutex_);
+      list->next = orphans_;
+      orphans_ = list;
+    }
+  }
+  orphanPending_.fetch_add(record.pending.exchange(0, std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+  if (record.hazards != nullptr) {
+    allocator_.deallocate(record.hazards, record.hazardCapacity * sizeof(void *));
+    record.hazards = nullptr;
+    record.hazardCount = 0;
+    record.hazardCapacity = 0;
+  }
+  record.freeSlots = (1u << kSlotsPerThread) - 1;
+  record.owned.store(false, std::memory_order_release);
+}
+
+void HazardDomain::releaseThreadRecord(void *domain, void *record) noexcept {
+  static_cast<HazardDomain *>(domain)->releaseRecord(
+      *static_cast<Record *>(record));
+}
+
+void HazardDomain::retire(void *ptr, ReclaimFn fn, std::size_t arg) {
+  Record &record = localRecord();
+  RetiredList *list = record.retired;
+  if (list == nullptr || list->count == list->capacity) {
+    list = growList(list, list == nullptr ? kInitialListCapacity
+                                          : list->capacity * 2);
+    record.retired = list;
+  }
+  list->entries()[list->count++] = {ptr, fn, arg};
+  record.pending.fetch_add(1, std::memory_order_relaxed);
+
+  const std::size_t slots =
+      kSlotsPerThread * recordCount_.load(std::memory_order_relaxed);
+  if (list->count >= std::max(kScanThreshold, 2 * slots)) {
+    scan(record);
+  }
+}
+
+void HazardDomain::collect() {
+  Record &record = localRecord();
+  RetiredList *orphans = nullptr;
+  if (orphanPending_.load(std::memory_order_relaxed) != 0) {
+    std::unique_lock<std::mutex> lock(orphanMutex_, std::try_to_lock);
+    if (lock.owns_lock()) {
+      orphans = std::exchange(orphans_, nullptr);
+    }
+  }
+  scan(record);
+  if (orphans == nullptr) {
+    return;
+  }
+
+  RetiredList *kept = nullptr;
+  while (RetiredList *list = orphans) {
+    orphans = list->next;
+    orphanPending_.fetch_sub(
+        reclaimUnprotected(*list, record.hazards, record.hazardCount),
+        std::memory_order_relaxed);
+    if (list->count == 0) {
+      freeList(list);
+    } else {
+      list->next = kept;
+      kept = list;
+    }
+  }
+  if (kept != nullptr) {
+    const std::lock_guard<std::mutex> lock(orphanMutex_);
+    while (RetiredList *list = kept) {
+      kept = list->next;
+      list->next = orphans_;
+      orphans_ = list;
+    }
+  }
+}
+
+std::size_t HazardDomain::pendingCount() const noexcept {
+  std::size_t n = orphanPending_.load(std::memory_order_relaxed);
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;
+       r = r->next) {
+    n += r->pending.load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+// Gathers every published hazard into the record's sorted hazard buffer and
+// reclaims the record's unprotected entries.
+void HazardDomain::scan(Record &record) {
+  // Nodes were unlinked before they were retired. The fence orders that
+  // before the slot loads: a reader whose slot is missed here re-checks its
+  // source after publishing and finds the node gone.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::size_t n = 0;
+  for (Record *r = records_.load(std::memory_order_acquire); r != nullptr;
+       r = r->next) {
+    for (const std::atomic<const void *> &slot : r->slots) {
+      const void *ptr = slot.load(std::memory_order_seq_cst);
+      if (ptr == nullptr) {
+        continue;
+      }
+      if (n == record.hazardCapacity) {
+        growHazards(record);
+      }
+      record.hazards[n++] = ptr;
+    }
+  }
+  std::sort(record.hazards, record.hazards + n, std::less<const void *>());
+  record.hazardCount = n;
+
+  if (record.retired != nullptr) {
+    record.pending.fetch_sub(reclaimUnprotected(*record.retired, record.hazards,
+                                                n),
+                             std::memory_order_relaxed);
+  }
+}
+
+void HazardDomain::growHazards(Record &record) {
+  const std::size_t capacity = std::max<std::size_t>(
+      record.hazardCapacity * 2,
+      kSlotsPerThread * recordCount_.load(std::memory_order_relaxed));
+  auto *hazards = static_cast<const void **>(
+      allocator_.allocate(capacity * sizeof(void *), alignof(void *)));
+  if (record.hazards != nullptr) {
+    std::copy_n(record.hazards, record.hazardCapacity, hazards);
+    allocator_.deallocate(record.hazards, record.hazardCapacity * sizeof(void *));
+  }
+  record.hazards = hazards;
+  record.hazardCapacity = capacity;
+}
+
+// Reclaims the entries of `list` not named in the sorted `hazards` and
+// compacts the rest. Returns the number reclaimed.
+std::size_t HazardDomain::reclaimUnprotected(RetiredList &list,
+                                             const void *const *hazards,
+                                             std::size_t hazardCount) noexcept {
+  detail::reclaim::Retired *entries = list.entries();
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < list.count; ++i) {
+    if (std::binary_search(hazards, hazards + hazardCount,
+                           static_cast<const void *>(entries[i].ptr),
+                           std::less<const void *>())) {
+      entries[kept++] = entries[i];
+    } else {
+      entries[i].reclaim(allocator_);
+    }
+  }
+  const std::size_t reclaimed = list.count - kept;
+  list.count = kept;
+  return reclaimed;
+}
+
+HazardDomain::RetiredList *HazardDomain::growList(RetiredList *list,
+                                                  std::size_t capacity) {
+  auto *grown = static_cast<RetiredList *>(allocator_.allocate(
+      RetiredList::bytes(capacity), alignof(RetiredList)));
+  grown->next = nullptr;
+  grown->count = 0;
+  grown->capacity = capacity;
+  if (list != nullptr) {
+    std::copy_n(list->entries(), list->count, grown->entries());
+    grown->count = list->count;
+    freeList(list);
+  }
+  return grown;
+}
+
+void HazardDomain::freeList(RetiredList *list) noexcept {
+  allocator_.deallocate(list, RetiredList::bytes(list->capacity));
+}
+
+} // namespace dakt::core
@@ -0,0 +1,93 @@
+#include "../../include/dakt/core/concurrency/Reclaim.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace dakt::core::detail::reclaim {
+
+// `mutex` orders an exiting thread's release against the domain's
+// destructor; `alive` is also read without it to prune dead entries.
+struct DomainLink {
+  DomainLink(void *d, ReleaseRecordFn r) noexcept : domain(d), release(r) {}
+
+  void *const domain;
+  const ReleaseRecordFn release;
+  std::mutex mutex;
+  std::atomic<bool> alive{true};
+  std::atomic<std::uint32_t> refs{1};
+};
+
+namespace {
+
+void unref(DomainLink *link) noexcept {
+  if (link->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete link;
+  }
+}
+
+struct ThreadRecords {
+  struct Entry {
+    DomainLink *link;
+    void *record;
+  };
+
+  ~ThreadRecords() {
+    for (const Entry &e : entries) {
+      {
+        const std::lock_guard<std::mutex> lock(e.link->mutex);
+        if (e.link->alive.load(std::memory_order_relaxed)) {
+          e.link->release(e.link->domain, e.record);
+        }
+      }
+      unref(e.link);
+    }
+  }
+
+  std::vector<Entry> entries;
+};
+
+thread_local ThreadRecords tlsRecords;
+
+} // namespace
+
+DomainLink *openDomainLink(void *domain, ReleaseRecordFn release) {
+  return new DomainLink(domain, release);
+}
+
+void closeDomainLink(DomainLink *link) noexcept {
+  {
+    const std::lock_guard<std::mutex> lock(link->mutex);
+    link->alive.store(false, std::memory_order_relaxed);
+  }
+  unref(link);
+}
+
+void *findThreadRecord(const DomainLink *link) noexcept {
+  for (const ThreadRecords::Entry &e : tlsRecords.entries) {
+    if (e.link == link) {
+      return e.record;
+    }
+  }
+  return nullptr;
+}
+
+void setThreadRecord(DomainLink *link, void *record) {
+  std::vector<ThreadRecords::Entry> &entries = tlsRecords.entries;
+  // Drop entries of dead domains, so a long-lived thread touching many
+  // short-lived domains keeps the lookup list short. This runs once per
+  // thread and domain. A held reference keeps a link's address from being
+  // reused while its entry exists.
+  std::erase_if(entries, [](const ThreadRecords::Entry &e) {
+    if (e.link->alive.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    unref(e.link);
+    return true;
+  });
+  link->refs.fetch_add(1, std::memory_order_relaxed);
+  entries.push_back({link, record});
+}
+
+} // namespace dakt::core::detail::reclaim
@@ -0,0 +1,151 @@
+#include "../../include/dakt/core/concurrency/TaskGraph.hpp"
+
+#include <chrono>
+
+namespace dakt::core {
+
+namespace {
+
+std::uint64_t nowNs() noexcept {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+} // namespace
+
+TaskGraph::~TaskGraph() = default;
+
+TaskGraph::NodeId
+TaskGraph::addNode(StringView name, Task work,
+                   std::initializer_list<NodeId> dependencies) {
+  return addNode(
+      name, std::move(work),
+      Span<const NodeId>(dependencies.begin(), dependencies.size()));
+}
+
+TaskGraph::NodeId TaskGraph::addNode(StringView name, Task work,
+                                     Span<const NodeId> dependencies) {
+  const auto id = static_cast<NodeId>(nodes_.size());
+  nodes_.push_back(Node{name.toString(), std::move(work), {}});
+  for (const NodeId dep : dependencies) {
+    addDependency(dep, id);
+  }
+  compiled_ = false;
+  return id;
+}
+
+void TaskGraph::addDependency(NodeId before, NodeId after) {
+  compiled_ = false;
+  if (before >= nodes_.size() || after >= nodes_.size()) {
+    unknownDependency_ = true;
+    return;
+  }
+  nodes_[before].successors.push_back(after);
+}
+
+Result<void, TaskGraphError> TaskGraph::compile() {
+  using R = Result<void, TaskGraphError>;
+  compiled_ = false;
+  if (unknownDependency_) {
+    return R::err(TaskGraphError::UnknownNode);
+  }
+  const std::size_t n = nodes_.size();
+
+  successorOffsets_.assign(n + 1, 0);
+  successorList_.clear();
+  dependencyCounts_.assign(n, 0);
+  roots_.clear();
+  for (std::size_t i = 0; i < n; ++i) {
+    successorOffsets_[i] = static_cast<std::uint32_t>(successorList_.size());
+    for (const NodeId next : nodes_[i].successors) {
+      successorList_.push_back(next);
+      ++dependencyCounts_[next];
+    }
+  }
+  successorOffsets_[n] = static_cast<std::uint32_t>(successorList_.size());
+
+  // Kahn's algorithm: if some node is never released, it sits on a cycle.
+  std::vector<std::uint32_t> remaining = dependencyCounts_;
+  std::vector<NodeId> order;
+  order.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if (dependencyCounts_[i] == 0) {
+      roots_.push_back(static_cast<NodeId>(i));
+      order.push_back(static_cast<NodeId>(i));
+    }
+  }
+  for (std::size_t head = 0; head < order.size(); ++head) {
+    const NodeId node = order[head];
+    for (std::uint32_t k = successorOffsets_[node];
+         k < successorOffsets_[node + 1]; ++k) {
+      if (--remaining[successorList_[k]] == 0) {
+        order.push_back(successorList_[k]);
+      }
+    }
+  }
+  if (order.size() != n) {
+    return R::err(TaskGraphError::Cycle);
+  }
+
+  pending_ = std::make_unique<std::atomic<std::uint32_t>[]>(n);
+  timings_.assign(n, TaskTiming{});
+  compiled_ = true;
+  return R::ok();
+}
+
+Result<void, TaskGraphError> TaskGraph::run(ThreadPool &pool) {
+  using R = Result<void, TaskGraphError>;
+  if (!compiled_) {
+    return R::err(TaskGraphError::NotCompiled);
+  }
+  for (std::size_t i = 0; i < nodes_.size(); ++i) {
+    pending_[i].store(dependencyCounts_[i], std::memory_order_relaxed);
+  }
+  runStartNs_ = nowNs();
+  {
+    TaskGroup group(pool);
+    for (const NodeId root : roots_) {
+      group.run([this, &group, root] { execute(group, root); });
+    }
+    group.wait();
+  }
+  lastRunNs_ = nowNs() - runStartNs_;
+  return R::ok();
+}
+
+void TaskGraph::execute(TaskGroup &group, NodeId node) noexcept {
+  for (;;) {
+    TaskTiming &timing = timings_[node];
+    timing.worker = group.pool().currentWorkerIndex();
+    const std::uint64_t start = nowNs();
+    if (Task &work = nodes_[node].work) {
+      work();
+    }
+    const std::uint64_t end = nowNs();
+    timing.startNs = start - runStartNs_;
+    timing.durationNs = end - start;
+
+    // Keep the first successor that became ready for this thread.
+    NodeId next = static_cast<NodeId>(nodes_.size());
+    for (std::uint32_t k = successorOffsets_[node];
+         k < successorOffsets_[node + 1]; ++k) {
+      const NodeId succ = successorList_[k];
+      if (pending_[succ].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        continue;
+      }
+      if (next == nodes_.size()) {
+        next = succ;
+      } else {
+        group.run([this, &group, succ] { execute(group, succ); });
+      }
+    }
+    if (next == nodes_.size()) {
+      return;
+    }
+    node = next;
+  }
+}
+
+} // namespace dakt::core
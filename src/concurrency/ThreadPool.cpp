@@ -0,0 +1,587 @@
+#include "../../include/dakt/core/concurrency/ThreadPool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace dakt::core {
+
+struct ThreadPool::Node {
+  Task task;
+  Node *next{nullptr};
+  NodeCache *home{nullptr};
+};
+
+// Free nodes of one owner. Only the owner touches `local`; other threads
+// return nodes through `remote`, which the owner empties in one exchange, so
+// the stack never pops concurrently and has no ABA problem.
+struct ThreadPool::NodeCache {
+  struct Slab {
+    Slab *next;
+    std::size_t size;
+  };
+
+  Node *local{nullptr};
+  alignas(64) std::atomic<Node *> remote{nullptr};
+  Slab *slabs{nullptr};
+};
+
+namespace {
+
+constexpr std::size_t kNodesPerSlab = 64;
+constexpr std::size_t kInitialDequeCapacity = 256;
+constexpr int kSpinRounds = 64;
+
+// Chase-Lev work-stealing deque of node pointers, following the C11
+// formulation of Le, Pop, Cohen and Zappa Nardelli (PPoPP'13). Buffers that
+// are outgrown stay alive until the deque is destroyed because a thief may
+// still be reading them; with doubling their total is below the live one.
+template <typename T> class ChaseLevDeque {
+public:
+  ChaseLevDeque(IAllocator &allocator, std::size_t capacity)
+      : allocator_(allocator) {
+    buffer_.store(makeBuffer(capacity, nullptr), std::memory_order_relaxed);
+  }
+
+  ~ChaseLevDeque() {
+    for (Buffer *b = buffer_.load(std::memory_order_relaxed); b != nullptr;) {
+      Buffer *older = b->retired;
+      allocator_.deallocate(b, bufferBytes(b->mask + 1));
+      b = older;
+    }
+  }
+
+  ChaseLevDeque(const ChaseLevDeque &) = delete;
+  ChaseLevDeque &operator=(const ChaseLevDeque &) = delete;
+
+  // Owner only.
+  void push(T *item) {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    const std::int64_t t = top_.load(std::memory_order_acquire);
+    Buffer *buf = buffer_.load(std::memory_order_relaxed);
+    if (b - t > static_cast<std::int64_t>(buf->mask)) {
+      buf = grow(buf, t, b);
+    }
+    buf->at(b).store(item, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  // Owner only.
+  T *pop() noexcept {
+    const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer *buf = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_seq_cst);
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *item = buf->at(b).load(std::memory_order_relaxed);
+    if (t == b) {
+      // Last item: race thieves for it.
+      if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Any thread. Returns nullptr when empty or when another thief won.
+  T *steal() noexcept {
+    std::int64_t t = top_.load(std::memory_order_seq_cst);
+    const std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+    if (t >= b) {
+      return nullptr;
+    }
+    Buffer *buf = buffer_.load(std::memory_order_acquire);
+    T *item = buf->at(t).load(std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  // Owner only; a thief may shrink it concurrently.
+  [[nodiscard]] bool empty() const noexcept {
+    return bottom_.load(std::memory_order_relaxed) <=
+           top_.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Buffer {
+    std::size_t mask;
+    Buffer *retired;
+
+    std::atomic<T *> &at(std::int64_t i) noexcept {
+      return slots()[static_cast<std::size_t>(i) & mask];
+    }
+    std::atomic<T *> *slots() noexcept {
+      return reinterpret_cast<std::atomic<T *> *>(this + 1);
+    }
+  };
+
+  static std::size_t bufferBytes(std::size_t capacity) noexcept {
+    return sizeof(Buffer) + capacity * sizeof(std::atomic<T *>);
+  }
+
+  Buffer *makeBuffer(std::size_t capacity, Buffer *retired) {
+    auto *buf = static_cast<Buffer *>(
+        allocator_.allocate(bufferBytes(capacity), alignof(Buffer)));
+    buf->mask = capacity - 1;
+    buf->retired = retired;
+    std::atomic<T *> *slots = buf->slots();
+    for (std::size_t i = 0; i < capacity; ++i) {
+      ::new (static_cast<void *>(slots + i)) std::atomic<T *>(nullptr);
+    }
+    return buf;
+  }
+
+  Buffer *grow(Buffer *old, std::int64_t t, std::int64_t b) {
+    Buffer *buf = makeBuffer((old->mask + 1) * 2, old);
+    for (std::int64_t i = t; i < b; ++i) {
+      buf->at(i).store(old->at(i).load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+    }
+    buffer_.store(buf, std::memory_order_release);
+    return buf;
+  }
+
+  IAllocator &allocator_;
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<Buffer *> buffer_{nullptr};
+};
+
+std::uint64_t nextRandom(std::uint64_t &state) noexcept {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+} // namespace
+
+struct alignas(64) ThreadPool::Worker {
+  Worker(IAllocator &allocator, std::size_t capacity)
+      : deque(allocator, capacity) {}
+
+  ChaseLevDeque<Node> deque;
+  NodeCache cache;
+  std::uint64_t rng{0};
+  // This worker's L3 neighbours, as a range of stealOrder_.
+  std::uint32_t nearBegin{0};
+  std::uint32_t nearEnd{0};
+  // Range of cpuIds_ to pin to.
+  std::uint32_t cpuBegin{0};
+  std::uint32_t cpuCount{0};
+  char name[16]{};
+  std::thread thread;
+};
+
+namespace {
+
+thread_local ThreadPool *tlsPool = nullptr;
+thread_local std::size_t tlsWorkerIndex = ThreadPool::npos;
+
+} // namespace
+
+ThreadPool::ThreadPool(IAllocator &allocator, const ThreadPoolOptions &options)
+    : allocator_(allocator), externalCache_(std::make_unique<NodeCache>()) {
+  workerCount_ = options.workerCount;
+  if (workerCount_ == 0 && options.placement == WorkerPlacement::None) {
+    workerCount_ = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const CpuTopology *topology = nullptr;
+  CpuTopology detected;
+  if (options.placement != WorkerPlacement::None) {
+    topology = options.topology;
+    if (topology == nullptr) {
+      detected = CpuTopology::detect();
+      topology = &detected;
+    }
+    if (workerCount_ == 0) {
+      workerCount_ = options.placement == WorkerPlacement::PhysicalCores
+                         ? topology->cores().size()
+                         : topology->cpus().size();
+      workerCount_ = std::max<std::size_t>(workerCount_, 1);
+    }
+  }
+  workers_ = static_cast<Worker *>(
+      allocator_.allocate(workerCount_ * sizeof(Worker), alignof(Worker)));
+  for (std::size_t i = 0; i < workerCount_; ++i) {
+    Worker *w = ::new (static_cast<void *>(workers_ + i))
+        Worker(allocator_, kInitialDequeCapacity);
+    w->rng = 0x9E3779B97F4A7C15ull * (i + 1);
+    if (!options.name.empty()) {
+      // Keep the index whole: cut the prefix instead.
+      char index[8];
+      const auto [end, ec] = std::to_chars(index, index + sizeof(index), i);
+      const std::size_t digits = ec == std::errc{} ? end - index : 0;
+      const std::size_t prefix =
+          std::min(options.name.size(), sizeof(w->name) - 2 - digits);
+      std::memcpy(w->name, options.name.data(), prefix);
+      w->name[prefix] = '-';
+      std::memcpy(w->name + prefix + 1, index, digits);
+    }
+  }
+  if (topology != nullptr) {
+    place(options.placement, *topology);
+  }
+  // Start threads only once every worker exists, since they steal from each
+  // other immediately.
+  for (std::size_t i = 0; i < workerCount_; ++i) {
+    workers_[i].thread = std::thread([this, i] { workerLoop(i); });
+  }
+}
+
+// Assigns worker i to place i (wrapping around) and groups the workers by
+// the L3 cache of their place. Per-CPU places take one hardware thread of
+// every core before any second sibling.
+void ThreadPool::place(WorkerPlacement placement,
+                       const CpuTopology &topology) {
+  const bool perCore = placement == WorkerPlacement::PhysicalCores;
+  std::vector<std::uint32_t> cpuOrder;
+  if (!perCore) {
+    for (std::uint32_t rank = 0; cpuOrder.size() < topology.cpus().size();
+         ++rank) {
+      for (const PhysicalCore &core : topology.cores()) {
+        if (rank < core.cpuCount) {
+          cpuOrder.push_back(core.firstCpu + rank);
+        }
+      }
+    }
+  }
+  const std::size_t places =
+      perCore ? topology.cores().size() : cpuOrder.size();
+  if (places == 0) {
+    return;
+  }
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < workerCount_; ++i) {
+    total += perCore ? topology.cores()[i % places].cpuCount : 1;
+  }
+  cpuIds_ = static_cast<std::uint32_t *>(
+      allocator_.allocate(total * sizeof(std::uint32_t),
+                          alignof(std::uint32_t)));
+  cpuIdCount_ = total;
+  stealOrder_ = static_cast<std::uint32_t *>(
+      allocator_.allocate(workerCount_ * sizeof(std::uint32_t),
+                          alignof(std::uint32_t)));
+
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < workerCount_; ++i) {
+    Worker &w = workers_[i];
+    w.cpuBegin = static_cast<std::uint32_t>(next);
+    if (perCore) {
+      for (const LogicalCpu &cpu :
+           topology.siblings(static_cast<std::uint32_t>(i % places))) {
+        cpuIds_[next++] = cpu.id;
+      }
+    } else {
+      cpuIds_[next++] = topology.cpus()[cpuOrder[i % places]].id;
+    }
+    w.cpuCount = static_cast<std::uint32_t>(next - w.cpuBegin);
+  }
+
+  auto l3Of = [&](std::uint32_t worker) {
+    return perCore ? topology.cores()[worker % places].l3
+                   : topology.cpus()[cpuOrder[worker % places]].l3;
+  };
+  std::iota(stealOrder_, stealOrder_ + workerCount_, 0u);
+  std::stable_sort(stealOrder_, stealOrder_ + workerCount_,
+                   [&](std::uint32_t a, std::uint32_t b) {
+                     return l3Of(a) < l3Of(b);
+                   });
+  for (std::size_t begin = 0; begin < workerCount_;) {
+    std::size_t end = begin + 1;
+    while (end < workerCount_ &&
+           l3Of(stealOrder_[end]) == l3Of(stealOrder_[begin])) {
+      ++end;
+    }
+    for (std::size_t k = begin; k < end; ++k) {
+      workers_[stealOrder_[k]].nearBegin = static_cast<std::uint32_t>(begin);
+      workers_[stealOrder_[k]].nearEnd = static_cast<std::uint32_t>(end);
+    }
+    begin = end;
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  stopping_.store(true, std::memory_order_seq_cst);
+  wakeSeq_.fetch_add(1, std::memory_order_release);
+  futexWakeAll(wakeSeq_);
+  for (std::size_t i = 0; i < workerCount_; ++i) {
+    workers_[i].thread.join();
+  }
+  // Workers drain all queues before exiting, but a task may still have been
+  // injected by a non-worker thread after they left.
+  while (Node *node = popInjected()) {
+    run(node, nullptr);
+  }
+
+  auto freeSlabs = [this](NodeCache &cache) {
+    for (NodeCache::Slab *s = cache.slabs; s != nullptr;) {
+      NodeCache::Slab *next = s->next;
+      allocator_.deallocate(s, s->size);
+      s = next;
+    }
+  };
+  for (std::size_t i = 0; i < workerCount_; ++i) {
+    freeSlabs(workers_[i].cache);
+    workers_[i].~Worker();
+  }
+  freeSlabs(*externalCache_);
+  allocator_.deallocate(workers_, workerCount_ * sizeof(Worker));
+  if (stealOrder_ != nullptr) {
+    allocator_.deallocate(stealOrder_, workerCount_ * sizeof(std::uint32_t));
+    allocator_.deallocate(cpuIds_, cpuIdCount_ * sizeof(std::uint32_t));
+  }
+}
+
+std::size_t ThreadPool::currentWorkerIndex() const noexcept {
+  return tlsPool == this ? tlsWorkerIndex : npos;
+}
+
+bool ThreadPool::localQueueEmpty() const noexcept {
+  const std::size_t index = currentWorkerIndex();
+  return index == npos || workers_[index].deque.empty();
+}
+
+ThreadPool::Node *ThreadPool::acquireNode(NodeCache &cache) {
+  if (cache.local == nullptr) {
+    cache.local = cache.remote.exchange(nullptr, std::memory_order_acquire);
+  }
+  if (cache.local == nullptr) {
+    constexpr std::size_t header =
+        (sizeof(NodeCache::Slab) + alignof(Node) - 1) & ~(alignof(Node) - 1);
+    const std::size_t size = header + kNodesPerSlab * sizeof(Node);
+    auto *slab = static_cast<NodeCache::Slab *>(
+        allocator_.allocate(size, alignof(Node)));
+    slab->next = cache.slabs;
+    slab->size = size;
+    cache.slabs = slab;
+    auto *nodes = reinterpret_cast<Node *>(reinterpret_cast<char *>(slab) +
+                                           header);
+    for (std::size_t i = 0; i < kNodesPerSlab; ++i) {
+      Node *n = ::new (static_cast<void *>(nodes + i)) Node();
+      n->home = &cache;
+      n->next = cache.local;
+      cache.local = n;
+    }
+  }
+  Node *node = cache.local;
+  cache.local = node->next;
+  return node;
+}
+
+void ThreadPool::releaseNode(Node *node, NodeCache *local) noexcept {
+  NodeCache *home = node->home;
+  if (home == local) {
+    node->next = home->local;
+    home->local = node;
+    return;
+  }
+  Node *head = home->remote.load(std::memory_order_relaxed);
+  do {
+    node->next = head;
+  } while (!home->remote.compare_exchange_weak(head, node,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+}
+
+void ThreadPool::run(Node *node, NodeCache *local) noexcept {
+  node->task();
+  node->task.reset();
+  releaseNode(node, local);
+}
+
+void ThreadPool::submit(Task task) {
+  const std::size_t index = currentWorkerIndex();
+  if (index != npos) {
+    Worker &w = workers_[index];
+    Node *node = acquireNode(w.cache);
+    node->task = std::move(task);
+    w.deque.push(node);
+  } else {
+    const std::lock_guard<std::mutex> lock(injectMutex_);
+    Node *node = acquireNode(*externalCache_);
+    node->task = std::move(task);
+    node->next = nullptr;
+    if (injectTail_ != nullptr) {
+      injectTail_->next = node;
+    } else {
+      injectHead_ = node;
+    }
+    injectTail_ = node;
+    injectCount_.fetch_add(1, std::memory_order_release);
+  }
+  notify();
+}
+
+// Wakes one sleeper if there is any. Pairs with the sleeper's increment of
+// sleepers_ followed by a last look for work: both are read-modify-writes of
+// sleepers_, so either this one reads the increment, or the sleeper's
+// increment reads from this one and its last look sees the new task.
+void ThreadPool::notify() noexcept {
+  if (sleepers_.fetch_add(0, std::memory_order_acq_rel) != 0) {
+    wakeSeq_.fetch_add(1, std::memory_order_release);
+    futexWakeOne(wakeSeq_);
+  }
+}
+
+ThreadPool::Node *ThreadPool::popInjected() noexcept {
+  if (injectCount_.load(std::memory_order_seq_cst) == 0) {
+    return nullptr;
+  }
+  const std::lock_guard<std::mutex> lock(injectMutex_);
+  Node *node = injectHead_;
+  if (node != nullptr) {
+    injectHead_ = node->next;
+    if (injectHead_ == nullptr) {
+      injectTail_ = nullptr;
+    }
+    injectCount_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return node;
+}
+
+// Tries the thief's L3 neighbours first, then every worker, each pass from
+// a random start.
+ThreadPool::Node *ThreadPool::steal(std::size_t self,
+                                    std::uint64_t &rng) noexcept {
+  if (self != npos) {
+    const Worker &w = workers_[self];
+    const std::size_t near = w.nearEnd - w.nearBegin;
+    if (near > 1 && near < workerCount_) {
+      const std::size_t start = nextRandom(rng) % near;
+      for (std::size_t k = 0; k < near; ++k) {
+        const std::size_t victim =
+            stealOrder_[w.nearBegin + (start + k) % near];
+        if (victim == self) {
+          continue;
+        }
+        if (Node *node = workers_[victim].deque.steal()) {
+          return node;
+        }
+      }
+    }
+  }
+  const std::size_t start = nextRandom(rng) % workerCount_;
+  for (std::size_t k = 0; k < workerCount_; ++k) {
+    const std::size_t victim = (start + k) % workerCount_;
+    if (victim == self) {
+      continue;
+    }
+    if (Node *node = workers_[victim].deque.steal()) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+ThreadPool::Node *ThreadPool::findWork(Worker *self) noexcept {
+  if (self != nullptr) {
+    if (Node *node = self->deque.pop()) {
+      return node;
+    }
+  }
+  if (Node *node = popInjected()) {
+    return node;
+  }
+  if (self != nullptr) {
+    return steal(static_cast<std::size_t>(self - workers_), self->rng);
+  }
+  thread_local std::uint64_t rng =
+      0xD1B54A32D192ED03ull ^ reinterpret_cast<std::uintptr_t>(&rng);
+  return steal(npos, rng);
+}
+
+bool ThreadPool::runPendingTask() {
+  const std::size_t index = currentWorkerIndex();
+  Worker *self = index != npos ? &workers_[index] : nullptr;
+  Node *node = findWork(self);
+  if (node == nullptr) {
+    return false;
+  }
+  run(node, self != nullptr ? &self->cache : nullptr);
+  return true;
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+  tlsPool = this;
+  tlsWorkerIndex = index;
+  Worker *self = &workers_[index];
+  if (self->cpuCount != 0) {
+    // Best effort, see the class comment.
+    (void)setCurrentThreadAffinity(Span<const std::uint32_t>(
+        cpuIds_ + self->cpuBegin, self->cpuCount));
+  }
+  if (self->name[0] != '\0') {
+    (void)setCurrentThreadName(StringView(self->name));
+  }
+
+  for (;;) {
+    Node *node = findWork(self);
+    for (int spin = 0; node == nullptr && spin < kSpinRounds; ++spin) {
+      cpuRelax();
+      node = findWork(self);
+    }
+    if (node != nullptr) {
+      run(node, &self->cache);
+      continue;
+    }
+
+    const std::uint32_t seq = wakeSeq_.load(std::memory_order_acquire);
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    node = findWork(self);
+    if (node == nullptr && !stopping_.load(std::memory_order_seq_cst)) {
+      futexWait(wakeSeq_, seq);
+    }
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    if (node != nullptr) {
+      run(node, &self->cache);
+    } else if (stopping_.load(std::memory_order_acquire)) {
+      // Leave only once nothing is left that this worker could run.
+      node = findWork(self);
+      if (node == nullptr) {
+        break;
+      }
+      run(node, &self->cache);
+    }
+  }
+
+  tlsPool = nullptr;
+  tlsWorkerIndex = npos;
+}
+
+void TaskGroup::wait() noexcept {
+  // Pool workers must keep running tasks while they wait: if every worker
+  // slept here, queued tasks the group depends on could never start.
+  const bool isWorker = pool_.currentWorkerIndex() != ThreadPool::npos;
+  int idle = 0;
+  for (;;) {
+    const std::uint32_t pending = pending_.load(std::memory_order_acquire);
+    if (pending == 0) {
+      return;
+    }
+    if (pool_.runPendingTask()) {
+      idle = 0;
+      continue;
+    }
+    if (++idle < kSpinRounds) {
+      cpuRelax();
+    } else if (isWorker) {
+      std::this_thread::yield();
+    } else {
+      futexWait(pending_, pending);
+    }
+  }
+}
+
+} // namespace dakt::core
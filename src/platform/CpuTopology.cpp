@@ -0,0 +1,257 @@
+#include "../../include/dakt/core/platform/CpuTopology.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include "../../include/dakt/core/text/Numbers.hpp"
+#include "../../include/dakt/core/text/Split.hpp"
+
+namespace dakt::core {
+
+namespace {
+
+// Group keys for CPUs sysfs said nothing about: the core's own L2, or an L3
+// per package. Kept apart from real keys, which are CPU numbers.
+constexpr std::uint64_t kPrivateL2 = std::uint64_t{1} << 32;
+constexpr std::uint64_t kPackageL3 = std::uint64_t{2} << 32;
+
+// CPU numbers at or above this are rejected, as setCurrentThreadAffinity
+// does (glibc's CPU_SETSIZE). It also bounds how much a malformed list in a
+// sysfs tree passed to fromSysfs() can expand to.
+constexpr std::uint32_t kMaxCpus = 1024;
+
+bool readText(const std::string &path, std::string &out) {
+  std::ifstream in(path);
+  if (!in) {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  out = std::move(buffer).str();
+  while (!out.empty() && (out.back() == '\n' || out.back() == ' ')) {
+    out.pop_back();
+  }
+  return true;
+}
+
+bool readUint(const std::string &path, std::uint32_t &out) {
+  std::string text;
+  if (!readText(path, text)) {
+    return false;
+  }
+  const auto value = parseInt<std::uint32_t>(StringView(text));
+  if (!value) {
+    return false;
+  }
+  out = value.value();
+  return true;
+}
+
+// Parses the kernel's list format, e.g. "0-3,8,10-11".
+bool parseCpuList(StringView text, std::vector<std::uint32_t> &out) {
+  out.clear();
+  if (text.empty()) {
+    return true;
+  }
+  for (const StringView part : split(text, ',')) {
+    const std::size_t dash = part.find('-');
+    const auto first = parseInt<std::uint32_t>(part.substr(0, dash));
+    if (!first || first.value() >= kMaxCpus) {
+      return false;
+    }
+    std::uint32_t last = first.value();
+    if (dash != StringView::npos) {
+      const auto end = parseInt<std::uint32_t>(part.substr(dash + 1));
+      if (!end || end.value() < last || end.value() >= kMaxCpus) {
+        return false;
+      }
+      last = end.value();
+    }
+    // last < kMaxCpus, so the counter cannot wrap.
+    for (std::uint32_t cpu = first.value(); cpu <= last; ++cpu) {
+      out.push_back(cpu);
+    }
+  }
+  return true;
+}
+
+bool readCpuList(const std::string &path, std::vector<std::uint32_t> &out) {
+  std::string text;
+  return readText(path, text) && parseCpuList(StringView(text), out);
+}
+
+// Lowest CPU listed in `path`, or `fallback`.
+std::uint64_t groupKey(const std::string &path, std::uint64_t fallback) {
+  std::vector<std::uint32_t> cpus;
+  if (!readCpuList(path, cpus) || cpus.empty()) {
+    return fallback;
+  }
+  return *std::min_element(cpus.begin(), cpus.end());
+}
+
+// Numbers distinct keys 0, 1, ... in order of first appearance.
+class DenseIndex {
+public:
+  std::uint32_t operator()(std::uint64_t key) {
+    for (std::size_t i = 0; i < keys_.size(); ++i) {
+      if (keys_[i] == key) {
+        return static_cast<std::uint32_t>(i);
+      }
+    }
+    keys_.push_back(key);
+    return static_cast<std::uint32_t>(keys_.size() - 1);
+  }
+  [[nodiscard]] std::uint32_t count() const noexcept {
+    return static_cast<std::uint32_t>(keys_.size());
+  }
+
+private:
+  std::vector<std::uint64_t> keys_;
+};
+
+} // namespace
+
+CpuTopology CpuTopology::build(std::vector<RawCpu> raw) {
+  std::sort(raw.begin(), raw.end(), [](const RawCpu &a, const RawCpu &b) {
+    return std::tie(a.numaNode, a.l3, a.core, a.id) <
+           std::tie(b.numaNode, b.l3, b.core, b.id);
+  });
+  CpuTopology topology;
+  DenseIndex cores, packages, nodes, l2s, l3s;
+  topology.cpus_.reserve(raw.size());
+  for (const RawCpu &r : raw) {
+    LogicalCpu cpu;
+    cpu.id = r.id;
+    cpu.core = cores(r.core);
+    cpu.package = packages(r.package);
+    cpu.numaNode = nodes(r.numaNode);
+    cpu.l2 = l2s(r.l2);
+    cpu.l3 = l3s(r.l3);
+    if (cpu.core == topology.cores_.size()) {
+      PhysicalCore core;
+      core.firstCpu = static_cast<std::uint32_t>(topology.cpus_.size());
+      core.package = cpu.package;
+      core.numaNode = cpu.numaNode;
+      core.l2 = cpu.l2;
+      core.l3 = cpu.l3;
+      topology.cores_.push_back(core);
+    }
+    ++topology.cores_[cpu.core].cpuCount;
+    topology.cpus_.push_back(cpu);
+  }
+  topology.packageCount_ = packages.count();
+  topology.numaNodeCount_ = nodes.count();
+  topology.l2Count_ = l2s.count();
+  topology.l3Count_ = l3s.count();
+  topology.raw_ = std::move(raw);
+  return topology;
+}
+
+Result<CpuTopology, PlatformError> CpuTopology::fromSysfs(StringView root) {
+  using R = Result<CpuTopology, PlatformError>;
+  const std::string base(root.data(), root.size());
+  std::vector<std::uint32_t> online;
+  if (!readCpuList(base + "/cpu/online", online) || online.empty()) {
+    return R::err(PlatformError::Unsupported);
+  }
+
+  std::vector<RawCpu> raw;
+  raw.reserve(online.size());
+  for (const std::uint32_t id : online) {
+    const std::string dir = base + "/cpu/cpu" + std::to_string(id);
+    RawCpu r{id, id, 0, 0, 0, 0};
+    r.core = groupKey(dir + "/topology/core_cpus_list",
+                      groupKey(dir + "/topology/thread_siblings_list", id));
+    std::uint32_t package = 0;
+    if (readUint(dir + "/topology/physical_package_id", package)) {
+      r.package = package;
+    }
+    r.l2 = kPrivateL2 | r.core;
+    r.l3 = kPackageL3 | r.package;
+    for (int index = 0;; ++index) {
+      const std::string cache = dir + "/cache/index" + std::to_string(index);
+      std::uint32_t level = 0;
+      if (!readUint(cache + "/level", level)) {
+        break;
+      }
+      std::string type;
+      if (readText(cache + "/type", type) && type == "Instruction") {
+        continue;
+      }
+      if (level == 2) {
+        r.l2 = groupKey(cache + "/shared_cpu_list", r.l2);
+      } else if (level == 3) {
+        r.l3 = groupKey(cache + "/shared_cpu_list", r.l3);
+      }
+    }
+    raw.push_back(r);
+  }
+
+  std::vector<std::uint32_t> nodes;
+  if (readCpuList(base + "/node/online", nodes)) {
+    std::vector<std::uint32_t> cpus;
+    for (const std::uint32_t node : nodes) {
+      if (!readCpuList(base + "/node/node" + std::to_string(node) + "/cpulist",
+                       cpus)) {
+        continue;
+      }
+      for (RawCpu &r : raw) {
+        if (std::find(cpus.begin(), cpus.end(), r.id) != cpus.end()) {
+          r.numaNode = node;
+        }
+      }
+    }
+  }
+  return R::ok(build(std::move(raw)));
+}
+
+CpuTopology CpuTopology::flat(std::uint32_t cpuCount) {
+  std::vector<RawCpu> raw;
+  raw.reserve(cpuCount);
+  for (std::uint32_t id = 0; id < cpuCount; ++id) {
+    raw.push_back({id, id, 0, 0, kPrivateL2 | id, kPackageL3});
+  }
+  return build(std::move(raw));
+}
+
+CpuTopology CpuTopology::detect() {
+  const CpuTopology &machine = cpuTopology();
+  auto allowed = currentThreadAffinity();
+  if (allowed && !allowed.value().empty()) {
+    CpuTopology restricted = machine.restrictedTo(Span<const std::uint32_t>(
+        allowed.value().data(), allowed.value().size()));
+    if (!restricted.cpus().empty()) {
+      return restricted;
+    }
+  }
+  return machine;
+}
+
+CpuTopology CpuTopology::restrictedTo(Span<const std::uint32_t> ids) const {
+  std::vector<RawCpu> raw;
+  for (const RawCpu &r : raw_) {
+    if (std::find(ids.begin(), ids.end(), r.id) != ids.end()) {
+      raw.push_back(r);
+    }
+  }
+  return build(std::move(raw));
+}
+
+const CpuTopology &cpuTopology() {
+  // The whole machine, whichever thread asks first; affinity masks are
+  // applied per call by detect().
+  static const CpuTopology topology = [] {
+    auto sysfs = CpuTopology::fromSysfs(StringView("/sys/devices/system", 19));
+    return sysfs ? std::move(sysfs).value()
+                 : CpuTopology::flat(
+                       std::max(1u, std::thread::hardware_concurrency()));
+  }();
+  return topology;
+}
+
+} // namespace dakt::core
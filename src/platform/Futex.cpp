@@ -0,0 +1,113 @@
+#include "../../include/dakt/core/platform/Futex.hpp"
+
+#if defined(__linux__)
+#include <cerrno>
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#endif
+
+namespace dakt::core {
+
+#if defined(__linux__)
+
+namespace {
+
+long futex(const std::atomic<std::uint32_t> &word, int op, std::uint32_t val,
+           const timespec *timeout) noexcept {
+  // The kernel only reads the word; the cast drops const for the syscall ABI.
+  return ::syscall(SYS_futex,
+                   const_cast<std::atomic<std::uint32_t> *>(&word), op, val,
+                   timeout, nullptr, 0);
+}
+
+} // namespace
+
+void futexWait(const std::atomic<std::uint32_t> &word,
+               std::uint32_t expected) noexcept {
+  futex(word, FUTEX_WAIT_PRIVATE, expected, nullptr);
+}
+
+bool futexWaitFor(const std::atomic<std::uint32_t> &word,
+                  std::uint32_t expected, std::uint64_t timeoutNs) noexcept {
+  const timespec timeout{static_cast<time_t>(timeoutNs / 1'000'000'000u),
+                         static_cast<long>(timeoutNs % 1'000'000'000u)};
+  return futex(word, FUTEX_WAIT_PRIVATE, expected, &timeout) == 0 ||
+         errno != ETIMEDOUT;
+}
+
+void futexWakeOne(const std::atomic<std::uint32_t> &word) noexcept {
+  futex(word, FUTEX_WAKE_PRIVATE, 1, nullptr);
+}
+
+void futexWakeAll(const std::atomic<std::uint32_t> &word) noexcept {
+  futex(word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+}
+
+#else
+
+namespace {
+
+// Waiters sleep on a condition variable picked by hashing the word's
+// address, so a wake never touches the word itself (unlike
+// std::atomic::notify_*, which needs the atomic alive). Words sharing a
+// bucket see each other's wakes as spurious ones.
+struct alignas(kCacheLineSize) Bucket {
+  std::mutex mutex;
+  std::condition_variable cv;
+};
+
+constexpr std::size_t kBucketCount = 64;
+
+Bucket &bucketFor(const void *address) noexcept {
+  static Bucket buckets[kBucketCount];
+  const auto key = reinterpret_cast<std::uintptr_t>(address);
+  return buckets[(key >> 2) % kBucketCount];
+}
+
+} // namespace
+
+void futexWait(const std::atomic<std::uint32_t> &word,
+               std::uint32_t expected) noexcept {
+  Bucket &bucket = bucketFor(&word);
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  // Wakers change the word before taking the lock, so a change made after
+  // this check finds us already waiting.
+  if (word.load(std::memory_order_acquire) == expected) {
+    bucket.cv.wait(lock);
+  }
+}
+
+bool futexWaitFor(const std::atomic<std::uint32_t> &word,
+                  std::uint32_t expected, std::uint64_t timeoutNs) noexcept {
+  Bucket &bucket = bucketFor(&word);
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  if (word.load(std::memory_order_acquire) != expected) {
+    return true;
+  }
+  return bucket.cv.wait_for(lock, std::chrono::nanoseconds(timeoutNs)) ==
+         std::cv_status::no_timeout;
+}
+
+// Other words may share the bucket, so even a single wake must reach every
+// sleeper in it.
+void futexWakeOne(const std::atomic<std::uint32_t> &word) noexcept {
+  futexWakeAll(word);
+}
+
+void futexWakeAll(const std::atomic<std::uint32_t> &word) noexcept {
+  Bucket &bucket = bucketFor(&word);
+  const std::lock_guard<std::mutex> lock(bucket.mutex);
+  bucket.cv.notify_all();
+}
+
+#endif
+
+} // namespace dakt::core
@@ -0,0 +1,88 @@
+#include "../../include/dakt/core/platform/Thread.hpp"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace dakt::core {
+
+#if defined(__linux__)
+
+Result<void, PlatformError>
+setCurrentThreadAffinity(Span<const std::uint32_t> cpus) noexcept {
+  using R = Result<void, PlatformError>;
+  if (cpus.empty()) {
+    return R::err(PlatformError::InvalidArgument);
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const std::uint32_t cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      return R::err(PlatformError::InvalidArgument);
+    }
+    CPU_SET(cpu, &set);
+  }
+  if (::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+    return R::err(PlatformError::SystemError);
+  }
+  return R::ok();
+}
+
+Result<std::vector<std::uint32_t>, PlatformError> currentThreadAffinity() {
+  using R = Result<std::vector<std::uint32_t>, PlatformError>;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+    return R::err(PlatformError::SystemError);
+  }
+  std::vector<std::uint32_t> cpus;
+  for (std::uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &set)) {
+      cpus.push_back(cpu);
+    }
+  }
+  return R::ok(std::move(cpus));
+}
+
+Result<void, PlatformError> setCurrentThreadName(StringView name) noexcept {
+  char buffer[16];
+  const std::size_t n = std::min(name.size(), sizeof(buffer) - 1);
+  std::memcpy(buffer, name.data(), n);
+  buffer[n] = '\0';
+  if (::pthread_setname_np(::pthread_self(), buffer) != 0) {
+    return Result<void, PlatformError>::err(PlatformError::SystemError);
+  }
+  return Result<void, PlatformError>::ok();
+}
+
+std::uint32_t currentCpu() noexcept {
+  const int cpu = ::sched_getcpu();
+  return cpu < 0 ? 0 : static_cast<std::uint32_t>(cpu);
+}
+
+#else
+
+Result<void, PlatformError>
+setCurrentThreadAffinity(Span<const std::uint32_t>) noexcept {
+  return Result<void, PlatformError>::err(PlatformError::Unsupported);
+}
+
+Result<std::vector<std::uint32_t>, PlatformError> currentThreadAffinity() {
+  return Result<std::vector<std::uint32_t>, PlatformError>::err(
+      PlatformError::Unsupported);
+}
+
+Result<void, PlatformError> setCurrentThreadName(StringView) noexcept {
+  return Result<void, PlatformError>::err(PlatformError::Unsupported);
+}
+
+std::uint32_t currentCpu() noexcept { return 0; }
+
+#endif
+
+} // namespace dakt::core
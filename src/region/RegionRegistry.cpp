@@ -0,0 +1,250 @@
+#include "../../include/dakt/core/region/RegionRegistry.hpp"
+#include "../../include/dakt/core/text/Numbers.hpp"
+#include "../../include/dakt/core/text/Split.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stop_token>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace dakt::core {
+
+namespace {
+
+StringView trim(StringView s) {
+  std::size_t begin = 0;
+  std::size_t end = s.size();
+  while (begin < end && (s[begin] == ' ' || s[begin] == '\t' ||
+                         s[begin] == '\r')) {
+    ++begin;
+  }
+  while (end > begin &&
+         (s[end - 1] == ' ' || s[end - 1] == '\t' || s[end - 1] == '\r')) {
+    --end;
+  }
+  return s.substr(begin, end - begin);
+}
+
+Result<std::string, std::string> readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    return Result<std::string, std::string>::err("cannot open " + path);
+  }
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  return Result<std::string, std::string>::ok(std::move(buffer).str());
+}
+
+} // namespace
+
+Result<std::vector<RegionEntry>, std::string>
+parseRegionLayout(StringView text) {
+  using R = Result<std::vector<RegionEntry>, std::string>;
+  std::vector<RegionEntry> entries;
+  std::size_t lineNo = 0;
+  for (StringView line : splitLines(text)) {
+    ++lineNo;
+    const std::size_t hash = line.find('#');
+    if (hash != StringView::npos) {
+      line = line.substr(0, hash);
+    }
+    line = trim(line);
+    if (line.empty()) {
+      continue;
+    }
+
+    const std::size_t eq = line.find('=');
+    const StringView name =
+        eq == StringView::npos ? StringView{} : trim(line.substr(0, eq));
+    if (name.empty()) {
+      return R::err("line " + std::to_string(lineNo) +
+                    ": expected `name = x, y, width, height`");
+    }
+
+    int values[4]{};
+    const auto fields =
+        parseColumn<int>(line.substr(eq + 1), ',', Span<int>(values, 4));
+    if (fields.isErr() || fields.value() != 4) {
+      return R::err("line " + std::to_string(lineNo) +
+                    ": invalid rect for region " + name.toString());
+    }
+
+    entries.push_back(
+        RegionEntry{name.toString(),
+                    Rect{values[0], values[1], values[2], values[3]}});
+  }
+  return R::ok(std::move(entries));
+}
+
+struct RegionRegistry::Watcher {
+  std::jthread thread;
+};
+
+RegionRegistry::RegionRegistry() : current_(new Snapshot{}) {}
+
+RegionRegistry::~RegionRegistry() {
+  stopWatching();
+  delete current_.load(std::memory_order_acquire);
+}
+
+StringView RegionRegistry::internName(const std::string &name) {
+  const auto it = namePool_.insert(name).first;
+  return StringView(*it);
+}
+
+void RegionRegistry::publish(Span<const RegionEntry> entries) {
+  const std::lock_guard lock(writeMutex_);
+
+  auto *next = new Snapshot{};
+  next->slots.reserve(entries.size());
+  for (const RegionEntry &entry : entries) {
+    next->slots.push_back(Slot{internName(entry.name), entry.rect});
+  }
+  // Stable sort + keep-last so that later duplicates override earlier ones.
+  std::stable_sort(
+      next->slots.begin(), next->slots.end(),
+      [](const Slot &a, const Slot &b) { return a.name < b.name; });
+  std::vector<Slot> unique;
+  unique.reserve(next->slots.size());
+  for (const Slot &slot : next->slots) {
+    if (!unique.empty() && unique.back().name == slot.name) {
+      unique.back() = slot;
+    } else {
+      unique.push_back(slot);
+    }
+  }
+  next->slots = std::move(unique);
+
+  swapIn(next);
+}
+
+void RegionRegistry::swapIn(Snapshot *next) {
+  const Snapshot *old = current_.exchange(next, std::memory_order_acq_rel);
+  // Readers that entered under the previous epoch may still hold `old`; new
+  // readers see the flipped epoch and therefore `next`.
+  const std::uint64_t retired =
+      epoch_.fetch_add(1, std::memory_order_seq_cst);
+  while (readers_[retired & 1].value.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+  delete old;
+  generation_.fetch_add(1, std::memory_order_release);
+}
+
+Result<void, std::string> RegionRegistry::loadFile(const std::string &path) {
+  return load(path, true);
+}
+
+Result<void, std::string> RegionRegistry::load(const std::string &path,
+                                               bool allowEmpty) {
+  auto text = readFile(path);
+  if (text.isErr()) {
+    return Result<void, std::string>::err(std::move(text).error());
+  }
+  auto entries = parseRegionLayout(StringView(text.value()));
+  if (entries.isErr()) {
+    return Result<void, std::string>::err(path + ": " +
+                                          std::move(entries).error());
+  }
+  if (!allowEmpty && entries.value().empty()) {
+    return Result<void, std::string>::err(path + ": no regions");
+  }
+  publish(Span<const RegionEntry>(entries.value().data(),
+                                  entries.value().size()));
+  return Result<void, std::string>::ok();
+}
+
+Result<void, std::string> RegionRegistry::watchFile(const std::string &path) {
+  stopWatching();
+  auto loaded = loadFile(path);
+  if (loaded.isErr()) {
+    return loaded;
+  }
+
+  auto watcher = std::make_unique<Watcher>();
+  const std::filesystem::path file(path);
+
+#if defined(__linux__)
+  const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (fd < 0) {
+    return Result<void, std::string>::err("inotify_init1 failed");
+  }
+  // Watch the directory: editors and deploy tools usually replace the file
+  // with a rename, which would orphan a watch on the file itself. Only
+  // finished writes count; IN_CREATE or IN_MODIFY would fire on a file that
+  // is still empty or half written.
+  const std::filesystem::path dir =
+      file.has_parent_path() ? file.parent_path() : std::filesystem::path(".");
+  if (inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    ::close(fd);
+    return Result<void, std::string>::err("cannot watch " + dir.string());
+  }
+
+  watcher->thread = std::jthread([this, fd, path,
+                                  name = file.filename().string()](
+                                     std::stop_token stop) {
+    alignas(inotify_event) char buffer[4096];
+    while (!stop.stop_requested()) {
+      pollfd pfd{fd, POLLIN, 0};
+      if (::poll(&pfd, 1, 100) <= 0) {
+        continue;
+      }
+      bool changed = false;
+      for (;;) {
+        const ssize_t len = ::read(fd, buffer, sizeof(buffer));
+        if (len <= 0) {
+          break;
+        }
+        for (ssize_t off = 0; off < len;) {
+          const auto *event =
+              reinterpret_cast<const inotify_event *>(buffer + off);
+          if (event->len != 0 && name == event->name) {
+            changed = true;
+          }
+          off += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+      }
+      if (changed && load(path, false).isErr()) {
+        reloadFailures_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    ::close(fd);
+  });
+#else
+  watcher->thread = std::jthread([this, path](std::stop_token stop) {
+    std::error_code ec;
+    auto last = std::filesystem::last_write_time(path, ec);
+    while (!stop.stop_requested()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+      const auto now = std::filesystem::last_write_time(path, ec);
+      if (ec || now == last) {
+        continue;
+      }
+      last = now;
+      if (load(path, false).isErr()) {
+        reloadFailures_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+#endif
+
+  watcher_ = std::move(watcher);
+  return Result<void, std::string>::ok();
+}
+
+void RegionRegistry::stopWatching() {
+  // jthread requests stop and joins on destruction.
+  watcher_.reset();
+}
+
+} // namespace dakt::core
@@ -0,0 +1,167 @@
+#include "../../include/dakt/core/text/StringInterner.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace dakt::core {
+
+namespace {
+
+constexpr std::size_t kBlockSize = 64 * 1024;
+constexpr std::size_t kInitialTableSize = 64;
+
+constexpr std::size_t alignUp(std::size_t n, std::size_t a) noexcept {
+  return (n + a - 1) & ~(a - 1);
+}
+
+} // namespace
+
+StringInterner::~StringInterner() {
+  for (Shard &shard : shards_) {
+    freeTable(shard.table.load(std::memory_order_relaxed));
+    for (std::size_t k = 0; k < kSegments; ++k) {
+      if (auto *segment = shard.segments[k].load(std::memory_order_relaxed)) {
+        allocator_.deallocate(segment,
+                              (kFirstSegment << k) * sizeof(EntrySlot));
+      }
+    }
+    for (Block *b = shard.blocks; b != nullptr;) {
+      Block *next = b->next;
+      allocator_.deallocate(b, b->size);
+      b = next;
+    }
+  }
+}
+
+Symbol StringInterner::intern(StringView text, std::uint64_t textHash) {
+  const std::uint32_t shardIndex = shardOf(textHash);
+  Shard &shard = shards_[shardIndex];
+  if (const Entry *e = shard.lookup(text, textHash)) {
+    return Symbol{e->id};
+  }
+
+  const std::lock_guard<std::mutex> lock(shard.writeMutex);
+  if (const Entry *e = shard.lookup(text, textHash)) {
+    return Symbol{e->id};
+  }
+  const std::uint32_t index = shard.count.load(std::memory_order_relaxed);
+  if (index >= kMaxPerShard) {
+    return Symbol{};
+  }
+  const std::uint32_t id = (shardIndex << kIndexBits) | (index + 1);
+  const Entry *e = store(shard, text, textHash, id);
+  publishEntry(shard, index, e);
+  insertIntoTable(shard, e);
+  shard.count.store(index + 1, std::memory_order_release);
+  return Symbol{id};
+}
+
+std::size_t StringInterner::size() const noexcept {
+  std::size_t n = 0;
+  for (const Shard &shard : shards_) {
+    n += shard.count.load(std::memory_order_acquire);
+  }
+  return n;
+}
+
+// Bump-allocates the entry header plus the null-terminated characters from
+// the shard's current block, chaining a new block when it runs out.
+const StringInterner::Entry *StringInterner::store(Shard &shard,
+                                                   StringView text,
+                                                   std::uint64_t textHash,
+                                                   std::uint32_t id) {
+  const std::size_t need =
+      alignUp(sizeof(Entry) + text.size() + 1, alignof(Entry));
+  if (need > shard.remaining) {
+    const std::size_t header = alignUp(sizeof(Block), alignof(Entry));
+    const std::size_t size = std::max(kBlockSize, header + need);
+    auto *block =
+        static_cast<Block *>(allocator_.allocate(size, alignof(Block)));
+    block->next = shard.blocks;
+    block->size = size;
+    shard.blocks = block;
+    shard.cursor = reinterpret_cast<char *>(block) + header;
+    shard.remaining = size - header;
+  }
+  auto *e = new (shard.cursor) Entry{textHash, id,
+                                     static_cast<std::uint32_t>(text.size())};
+  char *chars = shard.cursor + sizeof(Entry);
+  if (!text.empty()) {
+    std::memcpy(chars, text.data(), text.size());
+  }
+  chars[text.size()] = '\0';
+  shard.cursor += need;
+  shard.remaining -= need;
+  return e;
+}
+
+void StringInterner::publishEntry(Shard &shard, std::uint32_t index,
+                                  const Entry *e) {
+  const std::size_t j = std::size_t{index} + kFirstSegment;
+  const auto k = static_cast<std::size_t>(std::bit_width(j)) - 7;
+  auto *segment = shard.segments[k].load(std::memory_order_relaxed);
+  if (segment == nullptr) {
+    const std::size_t count = kFirstSegment << k;
+    segment = static_cast<EntrySlot *>(
+        allocator_.allocate(count * sizeof(EntrySlot), alignof(EntrySlot)));
+    for (std::size_t i = 0; i < count; ++i) {
+      new (segment + i) EntrySlot(nullptr);
+    }
+    shard.segments[k].store(segment, std::memory_order_release);
+  }
+  segment[j - (kFirstSegment << k)].store(e, std::memory_order_release);
+}
+
+void StringInterner::insertIntoTable(Shard &shard, const Entry *e) {
+  const Table *current = shard.table.load(std::memory_order_relaxed);
+  const std::size_t used = shard.count.load(std::memory_order_relaxed) + 1;
+  if (current == nullptr || used * 2 > current->mask + 1) {
+    // Build the larger table completely before readers can see it.
+    Table *grown = makeTable(current == nullptr ? kInitialTableSize
+                                                : (current->mask + 1) * 2);
+    if (current != nullptr) {
+      for (std::size_t i = 0; i <= current->mask; ++i) {
+        const Entry *old = current->slots[i].load(std::memory_order_relaxed);
+        if (old != nullptr) {
+          std::size_t s = old->hash & grown->mask;
+          while (grown->slots[s].load(std::memory_order_relaxed) != nullptr) {
+            s = (s + 1) & grown->mask;
+          }
+          grown->slots[s].store(old, std::memory_order_relaxed);
+        }
+      }
+      grown->retired = const_cast<Table *>(current);
+    }
+    shard.table.store(grown, std::memory_order_release);
+    current = grown;
+  }
+  std::size_t s = e->hash & current->mask;
+  while (current->slots[s].load(std::memory_order_relaxed) != nullptr) {
+    s = (s + 1) & current->mask;
+  }
+  current->slots[s].store(e, std::memory_order_release);
+}
+
+StringInterner::Table *StringInterner::makeTable(std::size_t capacity) {
+  const std::size_t header = alignUp(sizeof(Table), alignof(EntrySlot));
+  void *raw = allocator_.allocate(header + capacity * sizeof(EntrySlot),
+                                  alignof(Table));
+  auto *slots =
+      reinterpret_cast<EntrySlot *>(static_cast<char *>(raw) + header);
+  for (std::size_t i = 0; i < capacity; ++i) {
+    new (slots + i) EntrySlot(nullptr);
+  }
+  return new (raw) Table{capacity - 1, slots, nullptr};
+}
+
+void StringInterner::freeTable(const Table *t) noexcept {
+  const std::size_t header = alignUp(sizeof(Table), alignof(EntrySlot));
+  while (t != nullptr) {
+    const Table *retired = t->retired;
+    allocator_.deallocate(const_cast<Table *>(t),
+                          header + (t->mask + 1) * sizeof(EntrySlot));
+    t = retired;
+  }
+}
+
+} // namespace dakt::core
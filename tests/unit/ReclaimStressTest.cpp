@@ -0,0 +1,220 @@
+// Multi-threaded stress test for EpochManager and HazardDomain. Writers swap
+// nodes into shared slots and retire the old ones while readers dereference
+// whatever they find; a reader that sees a reclaimed node, a node reclaimed
+// twice or one never reclaimed fails the run. Nodes come from a preallocated
+// pool and reclaiming only marks them, so a premature reclaim is caught as a
+// state change rather than as a crash.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <dakt/core/concurrency/EpochManager.hpp>
+#include <dakt/core/concurrency/HazardPointers.hpp>
+#include <dakt/core/memory/SystemAllocator.hpp>
+
+namespace {
+
+using namespace dakt::core;
+
+constexpr std::size_t kSlots = 8;
+constexpr std::size_t kWriters = 3;
+constexpr std::size_t kReaders = 3;
+constexpr std::size_t kWritesPerWriter = 20000;
+// Short-lived threads that retire a few nodes and exit, so their leftovers
+// go through the exited-thread path.
+constexpr std::size_t kTransients = 16;
+constexpr std::size_t kWritesPerTransient = 100;
+
+enum State : std::uint32_t { kFree, kLive, kRetired, kReclaimed };
+
+struct Node {
+  std::atomic<std::uint32_t> state{kFree};
+  std::uint64_t payload{0};
+};
+
+struct Fixture {
+  std::vector<Node> nodes;
+  std::atomic<Node *> slots[kSlots]{};
+  std::atomic<std::size_t> nextNode{0};
+  std::atomic<std::size_t> retired{0};
+  std::atomic<std::size_t> reclaimed{0};
+  std::atomic<std::size_t> failures{0};
+  std::atomic<bool> stop{false};
+
+  explicit Fixture(std::size_t capacity) : nodes(capacity) {}
+
+  void fail(const char *what) {
+    if (failures.fetch_add(1, std::memory_order_relaxed) < 5) {
+      std::fprintf(stderr, "  failure: %s\n", what);
+    }
+  }
+
+  Node *fresh() {
+    Node &node = nodes[nextNode.fetch_add(1, std::memory_order_relaxed)];
+    node.payload = static_cast<std::uint64_t>(&node - nodes.data());
+    node.state.store(kLive, std::memory_order_relaxed);
+    return &node;
+  }
+
+  // Checks a node a reader may still dereference.
+  void inspect(const Node *node) {
+    const std::uint32_t state = node->state.load(std::memory_order_acquire);
+    if (state != kLive && state != kRetired) {
+      fail("reader saw a reclaimed node");
+    }
+    if (node->payload != static_cast<std::uint64_t>(node - nodes.data())) {
+      fail("reader saw a corrupted node");
+    }
+  }
+};
+
+Fixture *current = nullptr;
+
+void markReclaimed(IAllocator &, void *ptr, std::size_t) noexcept {
+  auto *node = static_cast<Node *>(ptr);
+  std::uint32_t expected = kRetired;
+  if (!node->state.compare_exchange_strong(expected, kReclaimed,
+                                           std::memory_order_acq_rel)) {
+    current->fail("node reclaimed twice or before it was retired");
+  }
+  current->reclaimed.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Domain>
+void replace(Fixture &f, Domain &domain, std::size_t i) {
+  Node *old = f.slots[i % kSlots].exchange(f.fresh(), std::memory_order_acq_rel);
+  if (old != nullptr) {
+    old->state.store(kRetired, std::memory_order_release);
+    f.retired.fetch_add(1, std::memory_order_relaxed);
+    domain.retire(old, &markReclaimed, 0);
+  }
+}
+
+template <typename Domain> void drain(Fixture &f, Domain &domain) {
+  for (std::size_t i = 0; i < kSlots; ++i) {
+    if (Node *node = f.slots[i].exchange(nullptr)) {
+      node->state.store(kRetired, std::memory_order_release);
+      f.retired.fetch_add(1, std::memory_order_relaxed);
+      domain.retire(node, &markReclaimed, 0);
+    }
+  }
+  for (int i = 0; i < 1000 && domain.pendingCount() != 0; ++i) {
+    domain.collect();
+  }
+  if (domain.pendingCount() != 0) {
+    f.fail("collect() left retired nodes behind with no readers");
+  }
+}
+
+// Holds a node across a yield every few reads, so writers get to retire and
+// try to reclaim it while it is still in use even on a single core.
+void hold(Fixture &f, const Node *node, std::size_t i) {
+  f.inspect(node);
+  if (i % 8 == 0) {
+    std::this_thread::yield();
+    f.inspect(node);
+  }
+}
+
+// Reader policies: read a few slots under the scheme's protection.
+struct EpochReader {
+  static void read(Fixture &f, EpochManager &domain, std::size_t i) {
+    const auto guard = domain.pin();
+    for (int k = 0; k < 4; ++k) {
+      if (const Node *node =
+              f.slots[(i + k) % kSlots].load(std::memory_order_acquire)) {
+        hold(f, node, i + k);
+      }
+    }
+  }
+};
+
+struct HazardReader {
+  static void read(Fixture &f, HazardDomain &domain, std::size_t i) {
+    HazardDomain::Holder holder(domain);
+    for (int k = 0; k < 4; ++k) {
+      if (const Node *node = holder.protect(f.slots[(i + k) % kSlots])) {
+        hold(f, node, i + k);
+      }
+    }
+  }
+};
+
+template <typename Domain, typename Reader> bool stress(const char *name) {
+  const std::size_t capacity = kWriters * kWritesPerWriter +
+                               kTransients * kWritesPerTransient + kSlots;
+  auto fixture = std::make_unique<Fixture>(capacity);
+  Fixture &f = *fixture;
+  current = &f;
+  SystemAllocator allocator;
+  {
+    Domain domain(allocator);
+    std::vector<std::thread> readers;
+    for (std::size_t r = 0; r < kReaders; ++r) {
+      readers.emplace_back([&f, &domain, r] {
+        for (std::size_t i = r; !f.stop.load(std::memory_order_relaxed); ++i) {
+          Reader::read(f, domain, i);
+        }
+      });
+    }
+    std::vector<std::thread> writers;
+    for (std::size_t w = 0; w < kWriters; ++w) {
+      writers.emplace_back([&f, &domain, w] {
+        for (std::size_t i = 0; i < kWritesPerWriter; ++i) {
+          replace(f, domain, w + i);
+          if (i % 1024 == 0) {
+            domain.collect();
+          }
+          if (i % 64 == 0) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (std::size_t t = 0; t < kTransients; ++t) {
+      std::thread([&f, &domain, t] {
+        for (std::size_t i = 0; i < kWritesPerTransient; ++i) {
+          replace(f, domain, t + i);
+        }
+      }).join();
+    }
+    for (std::thread &t : writers) {
+      t.join();
+    }
+    f.stop.store(true, std::memory_order_relaxed);
+    for (std::thread &t : readers) {
+      t.join();
+    }
+    drain(f, domain);
+  }
+
+  if (f.reclaimed.load() != f.retired.load()) {
+    f.fail("retired and reclaimed counts differ");
+  }
+  for (const Node &node : f.nodes) {
+    const std::uint32_t state = node.state.load();
+    if (state == kLive || state == kRetired) {
+      f.fail("node never reclaimed");
+      break;
+    }
+  }
+  const bool ok = f.failures.load() == 0;
+  std::printf("%s %s: %zu retired, %zu reclaimed\n", ok ? "PASS" : "FAIL",
+              name, f.retired.load(), f.reclaimed.load());
+  current = nullptr;
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  bool ok = true;
+  ok &= stress<EpochManager, EpochReader>("EpochManager");
+  ok &= stress<HazardDomain, HazardReader>("HazardDomain");
+  return ok ? 0 : 1;
+}